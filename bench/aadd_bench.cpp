@@ -0,0 +1,221 @@
+/**
+
+ @file aadd_bench.cpp
+
+ @ingroup AADD
+
+ @brief Scaling benchmarks of AADD workloads.
+
+ @details The scenarios are derived from the regression tests and examples:
+ - BM_waterlevel: the water level monitor of test/waterlevel.cpp;
+   arguments are the number of time steps and of uncertainty sources of the rate.
+ - BM_while: the loop of test/while_stmt.cpp;
+   arguments are the number of loop iterations and the width of the initial range.
+ - BM_nested_if: conditional statements nested to a given depth on a sum of uncertainty sources;
+   arguments are the nesting depth and the number of sources.
+ - BM_sigma_delta: a discrete-time sigma-delta modulator built from the integrator, quantizer
+   and adder of examples/sigma-delta-mod; arguments are the number of time steps and the order.
+ - BM_lp_solver: the water level monitor with 20 time steps, with the LP solved by GLPK (first
+   argument 0), by the in-library solver (1) or by both (2); the second argument is the number
+   of sources. With both solvers, the time of each and the number of LPs on which they disagree
+   are reported.
+ @details Besides time and allocations, each benchmark reports the nodes and leaves of the
+ result, the LP calls and LP time per iteration and the peak resident set size of the process.
+
+ @copyright@parblock
+ Copyright (c) 2017  Carna Radojicic, Christoph Grimm, Design of Cyber-Physical Systems
+ TU Kaiserslautern Postfach 3049 67663 Kaiserslautern radojicic@cs.uni-kl.de
+
+ This file is part of AADD package.
+
+ AADD is free software: you can redistribute it and/or modify it
+ under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ AADD is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public
+ License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with AADD package. If not, see <http://www.gnu.org/licenses/>.
+ @endparblock
+ */
+
+#include <sys/resource.h>
+
+#include "../src/aadd.h"
+#include "bench.h"
+
+
+/**
+ @brief Adds the counters of a scenario run to the state.
+ */
+static void report(benchState& state, const AADD& result, const lp_counters& start)
+{
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+
+    state.counters["nodes"]        = result.numNodes();
+    state.counters["leaves"]       = result.numLeaves();
+    state.counters["lp_calls"]     = (double)(lpCounters().calls-start.calls)/state.iterations();
+    state.counters["lp_ms"]        = 1e3*(lpCounters().seconds-start.seconds)/state.iterations();
+    state.counters["peak_rss_kb"]  = usage.ru_maxrss;
+}
+
+/**
+ @brief Sum of n uncertainty sources with total range [-r, r].
+ */
+static AAF sources(unsigned n, double r)
+{
+    AAF sum(0.0);
+    for (unsigned i=0; i < n; i++)
+        sum = sum + AAF(-r/n, r/n);
+    return sum;
+}
+
+
+static void BM_waterlevel(benchState& state)
+{
+    lp_counters start = lpCounters();
+    AADD level;
+    while (state.keepRunning())
+    {
+        AAF uncertainty = sources(state.arg(1), 0.2);
+        AADD rate(.8);
+        rate  = rate + uncertainty;
+        level = 5.0;
+
+        for (long i=1; i < state.arg(0); i++)
+        {
+            ifS ( level >= 10.0 )
+                rate = -.8+uncertainty;
+            endS;
+
+            ifS ( level < 2.0 )
+                rate = .8+uncertainty;
+            endS;
+
+            level = level + rate;
+        }
+    }
+    report(state, level, start);
+}
+BENCHMARK(BM_waterlevel)->args({10, 1})->args({20, 1})->args({40, 1})->args({20, 4})->args({20, 16});
+
+
+static void BM_while(benchState& state)
+{
+    lp_counters start = lpCounters();
+    doubleS a, b;
+    while (state.keepRunning())
+    {
+        double limit = state.arg(0);
+        a = doubleS(0, state.arg(1));
+        b = doubleS(10, 12);
+
+        whileS(a < limit)
+        {
+            a = a + 1;
+            b = b - 10;
+        } endS
+    }
+    report(state, a, start);
+}
+BENCHMARK(BM_while)->args({10, 2})->args({20, 2})->args({40, 2})->args({20, 8});
+
+
+static void BM_nested_if(benchState& state)
+{
+    lp_counters start = lpCounters();
+    doubleS y;
+    while (state.keepRunning())
+    {
+        doubleS x = doubleS(0, 10) + sources(state.arg(1), 1.0);
+        y = 0.0;
+        for (long d=0; d < state.arg(0); d++)
+        {
+            // opens nested blocks; the conditions split the range of x.
+            bCond().thenBlock(x > 10.0*(d+1)/(state.arg(0)+1));
+            y = y + x;
+        }
+        for (long d=0; d < state.arg(0); d++)
+            bCond().endBlock(__LINE__, __FILE__);
+    }
+    report(state, y, start);
+}
+BENCHMARK(BM_nested_if)->args({2, 1})->args({4, 1})->args({8, 1})->args({4, 4})->args({4, 16});
+
+
+static void BM_sigma_delta(benchState& state)
+{
+    lp_counters start = lpCounters();
+    doubleS y;
+    while (state.keepRunning())
+    {
+        doubleS u = doubleS(-0.5, 0.5);          // input
+        vector<doubleS> integ(state.arg(1), doubleS(0.0));
+        doubleS v = 0.0;                          // quantizer output, fed back
+
+        for (long t=0; t < state.arg(0); t++)
+        {
+            // cascade of integrators, each with feedback of the quantizer output.
+            doubleS in = u;
+            for (unsigned k=0; k < integ.size(); k++)
+            {
+                integ[k] = integ[k] + (in - v);
+                in = integ[k];
+            }
+            y = in;
+
+            ifS(y >= 0.0)
+                v = 1.0;
+            elseS
+                v = -1.0;
+            endS
+        }
+    }
+    report(state, y, start);
+}
+BENCHMARK(BM_sigma_delta)->args({4, 1})->args({8, 1})->args({16, 1})->args({8, 2});
+
+
+static void BM_lp_solver(benchState& state)
+{
+    lp_options saved = lpOptions();
+    const lp_solver solvers[3] = { LP_SOLVER_GLPK, LP_SOLVER_BUILTIN, LP_SOLVER_COMPARE };
+    lpOptions().solver = solvers[state.arg(0)];
+    lpComparison() = lp_comparison();
+    lp_counters start = lpCounters();
+    AADD level;
+    while (state.keepRunning())
+    {
+        AAF uncertainty = sources(state.arg(1), 0.2);
+        AADD rate(.8);
+        rate  = rate + uncertainty;
+        level = 5.0;
+
+        for (unsigned i=1; i < 20; i++)
+        {
+            ifS ( level >= 10.0 )
+                rate = -.8+uncertainty;
+            endS;
+
+            ifS ( level < 2.0 )
+                rate = .8+uncertainty;
+            endS;
+
+            level = level + rate;
+        }
+    }
+    report(state, level, start);
+    if (lpOptions().solver == LP_SOLVER_COMPARE)
+    {
+        state.counters["glpk_ms"]       = 1e3*lpComparison().seconds_glpk/state.iterations();
+        state.counters["builtin_ms"]    = 1e3*lpComparison().seconds_builtin/state.iterations();
+        state.counters["disagreements"] = lpComparison().disagreements;
+    }
+    lpOptions() = saved;
+}
+BENCHMARK(BM_lp_solver)->args({0, 1})->args({1, 1})->args({2, 1})->args({0, 16})->args({1, 16})->args({2, 16});
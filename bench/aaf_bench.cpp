@@ -0,0 +1,123 @@
+/**
+
+ @file aaf_bench.cpp
+
+ @ingroup AADD
+
+ @brief Microbenchmarks of the arithmetic of affine forms.
+
+ @details The binary operations are measured for affine forms with 1 to 512 noise symbols,
+ of which 0%, 50% or 100% are shared by both operands. The arguments of a binary benchmark
+ are the number of symbols and the overlap in percent; unary benchmarks take the number
+ of symbols. All operands are in the range [9, 11], where all functions are defined.
+
+ @copyright@parblock
+ Copyright (c) 2017  Carna Radojicic, Christoph Grimm, Design of Cyber-Physical Systems
+ TU Kaiserslautern Postfach 3049 67663 Kaiserslautern radojicic@cs.uni-kl.de
+
+ This file is part of AADD package.
+
+ AADD is free software: you can redistribute it and/or modify it
+ under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ AADD is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public
+ License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with AADD package. If not, see <http://www.gnu.org/licenses/>.
+ @endparblock
+ */
+
+#include "../src/aa.h"
+#include "bench.h"
+
+
+/**
+ @brief Creates an affine form with center 10 and radius 1 with the given noise symbols.
+ */
+static AAF makeAAF(const vector<unsigned>& indexes)
+{
+    vector<double> dev(indexes.size());
+    for (unsigned i=0; i < dev.size(); i++)
+        dev[i] = (i % 2 ? -1.0 : 1.0)/dev.size();
+    return AAF(10.0, dev.data(), indexes.data(), indexes.size());
+}
+
+/**
+ @brief Creates two operands with n symbols each, of which overlap percent are shared.
+ */
+static void makeOperands(unsigned n, unsigned overlap, AAF& a, AAF& b)
+{
+    unsigned shared = n*overlap/100;
+    vector<unsigned> ia, ib;
+    for (unsigned i=0; i < n; i++)
+    {
+        ia.push_back(i+1);
+        ib.push_back(i < shared ? i+1 : n+i+1);
+    }
+    a = makeAAF(ia);
+    b = makeAAF(ib);
+}
+
+
+// symbol counts and overlap ratios of the binary operations.
+static benchmark* binaryArgs(benchmark* b)
+{
+    const unsigned symbols[] = { 1, 8, 64, 512 };
+    const unsigned overlaps[] = { 0, 50, 100 };
+    for (auto n: symbols)
+        for (auto o: overlaps)
+            b->args(vector<long>{ (long) n, (long) o });
+    return b;
+}
+
+// symbol counts of the unary operations.
+static benchmark* unaryArgs(benchmark* b)
+{
+    return b->arg(1)->arg(8)->arg(64)->arg(512);
+}
+
+
+#define BINARY_BENCHMARK(name, expr)                 \
+static void name(benchState& state)                  \
+{                                                    \
+    AAF a(0.0), b(0.0);                              \
+    makeOperands(state.arg(0), state.arg(1), a, b);  \
+    while (state.keepRunning())                      \
+    {                                                \
+        AAF r = expr;                                \
+        doNotOptimize(r);                            \
+    }                                                \
+}                                                    \
+static benchmark* BENCH_CONCAT(bench_, name) = binaryArgs(registerBenchmark(#name, name))
+
+#define UNARY_BENCHMARK(name, expr)                  \
+static void name(benchState& state)                  \
+{                                                    \
+    AAF a(0.0), b(0.0);                              \
+    makeOperands(state.arg(0), 100, a, b);           \
+    while (state.keepRunning())                      \
+    {                                                \
+        AAF r = expr;                                \
+        doNotOptimize(r);                            \
+    }                                                \
+}                                                    \
+static benchmark* BENCH_CONCAT(bench_, name) = unaryArgs(registerBenchmark(#name, name))
+
+
+BINARY_BENCHMARK(BM_add, a + b);
+BINARY_BENCHMARK(BM_sub, a - b);
+BINARY_BENCHMARK(BM_mul, a * b);
+BINARY_BENCHMARK(BM_div, a / b);
+
+UNARY_BENCHMARK(BM_pow3, a ^ 3);
+UNARY_BENCHMARK(BM_sqrt, sqrt(a));
+UNARY_BENCHMARK(BM_exp,  exp(a));
+UNARY_BENCHMARK(BM_log,  log(a));
+UNARY_BENCHMARK(BM_sin,  sin(a));
+UNARY_BENCHMARK(BM_atan, atan(a));
+UNARY_BENCHMARK(BM_tanh, tanh(a));
@@ -0,0 +1,241 @@
+/**
+
+ @file bench.cpp
+
+ @ingroup AADD
+
+ @brief A small harness for microbenchmarks; runner, allocation counting and main.
+
+ @copyright@parblock
+ Copyright (c) 2017  Carna Radojicic, Christoph Grimm, Design of Cyber-Physical Systems
+ TU Kaiserslautern Postfach 3049 67663 Kaiserslautern radojicic@cs.uni-kl.de
+
+ This file is part of AADD package.
+
+ AADD is free software: you can redistribute it and/or modify it
+ under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ AADD is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public
+ License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with AADD package. If not, see <http://www.gnu.org/licenses/>.
+ @endparblock
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <atomic>
+#include <chrono>
+#include <new>
+
+#include "bench.h"
+
+
+// Heap allocations are counted by replacing the global operator new.
+static std::atomic<unsigned long> allocation_count(0);
+
+unsigned long benchAllocations()
+{
+    return allocation_count.load(std::memory_order_relaxed);
+}
+
+void* operator new(size_t size)
+{
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    void* p = malloc(size > 0 ? size : 1);
+    if (p == nullptr) throw std::bad_alloc();
+    return p;
+}
+
+void* operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void* p) noexcept
+{
+    free(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+    free(p);
+}
+
+
+static double now()
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+
+benchState::benchState(unsigned long iterations, const vector<long>& a): args(a)
+{
+    max_iter = iterations;
+    iter = 0;
+    running = false;
+    seconds = start = 0;
+    allocs = start_allocs = 0;
+}
+
+void benchState::start_timer()
+{
+    running = true;
+    start_allocs = benchAllocations();
+    start = now();
+}
+
+void benchState::stop_timer()
+{
+    seconds += now()-start;
+    allocs  += benchAllocations()-start_allocs;
+    running = false;
+}
+
+bool benchState::keepRunning()
+{
+    if (iter == 0 and !running) start_timer();
+    if (iter < max_iter)
+    {
+        iter++;
+        return true;
+    }
+    if (running) stop_timer();
+    return false;
+}
+
+void benchState::pauseTiming()
+{
+    if (running) stop_timer();
+}
+
+void benchState::resumeTiming()
+{
+    if (!running) start_timer();
+}
+
+
+benchmark::benchmark(const string& n, benchFunction f): name(n), function(f)
+{
+    fixed_iterations = 0;
+}
+
+benchmark* benchmark::arg(long a)
+{
+    arg_sets.push_back(vector<long>(1, a));
+    return this;
+}
+
+benchmark* benchmark::args(const vector<long>& a)
+{
+    arg_sets.push_back(a);
+    return this;
+}
+
+benchmark* benchmark::iterations(unsigned long n)
+{
+    fixed_iterations = n;
+    return this;
+}
+
+
+static vector<benchmark*>& registry()
+{
+    static vector<benchmark*> benchmarks;
+    return benchmarks;
+}
+
+benchmark* registerBenchmark(const string& name, benchFunction f)
+{
+    registry().push_back(new benchmark(name, f));
+    return registry().back();
+}
+
+
+/**
+ @brief Runs a benchmark with increasing number of iterations until it takes min_time.
+ */
+static benchState runOne(const benchmark& b, const vector<long>& args, double min_time)
+{
+    unsigned long n = b.fixed_iterations > 0 ? b.fixed_iterations : 1;
+    while (true)
+    {
+        benchState state(n, args);
+        b.function(state);
+
+        if (b.fixed_iterations > 0 or state.elapsed() >= min_time or n >= 1000000000UL)
+            return state;
+
+        double factor = state.elapsed() > 0 ? 1.4*min_time/state.elapsed() : 100;
+        if (factor < 2) factor = 2;
+        if (factor > 100) factor = 100;
+        n = (unsigned long)(n*factor);
+    }
+}
+
+
+int runBenchmarks(int argc, char* argv[])
+{
+    string filter;
+    double min_time = 0.2;
+    bool csv = false;
+
+    for (int i=1; i < argc; i++)
+    {
+        if (strncmp(argv[i], "--filter=", 9) == 0) filter = argv[i]+9;
+        else if (strncmp(argv[i], "--min_time=", 11) == 0) min_time = atof(argv[i]+11);
+        else if (strcmp(argv[i], "--csv") == 0) csv = true;
+        else
+        {
+            fprintf(stderr, "usage: %s [--filter=text] [--min_time=seconds] [--csv]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    if (csv) printf("name,iterations,ns_per_iter,allocs_per_iter,label,counters\n");
+    else printf("%-40s %12s %14s %12s\n", "Benchmark", "Iterations", "Time [ns]", "Allocs");
+
+    for (auto b: registry())
+    {
+        vector<vector<long> > arg_sets = b->arg_sets;
+        if (arg_sets.empty()) arg_sets.push_back(vector<long>());
+
+        for (auto& args: arg_sets)
+        {
+            string name = b->name;
+            for (auto a: args) name += "/" + to_string(a);
+            if (!filter.empty() and name.find(filter) == string::npos) continue;
+
+            benchState s = runOne(*b, args, min_time);
+            double ns     = 1e9*s.elapsed()/s.iterations();
+            double allocs = (double) s.allocations()/s.iterations();
+
+            string counters;
+            for (auto& c: s.counters)
+            {
+                char value[32];
+                snprintf(value, sizeof(value), "%g", c.second);
+                counters += (counters.empty() ? "" : " ") + c.first + "=" + value;
+            }
+
+            if (csv) printf("%s,%lu,%.1f,%.2f,%s,%s\n", name.c_str(), s.iterations(), ns, allocs,
+                            s.getLabel().c_str(), counters.c_str());
+            else printf("%-40s %12lu %14.1f %12.2f %s %s\n", name.c_str(), s.iterations(), ns, allocs,
+                        s.getLabel().c_str(), counters.c_str());
+            fflush(stdout);
+        }
+    }
+    return 0;
+}
+
+
+int main(int argc, char* argv[])
+{
+    return runBenchmarks(argc, argv);
+}
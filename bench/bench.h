@@ -0,0 +1,137 @@
+/**
+
+ @file bench.h
+
+ @ingroup AADD
+
+ @brief A small harness for microbenchmarks in the style of Google Benchmark.
+
+ @details A benchmark is a function that runs its body while state.keepRunning() returns true.
+ The harness increases the number of iterations until the measurement takes at least the
+ minimum time, and reports time and heap allocations per iteration:
+ @verbatim
+   static void BM_add(benchState& state)
+   {
+       AAF a = ..., b = ...;
+       while (state.keepRunning())
+           doNotOptimize(a + b);
+   }
+   BENCHMARK(BM_add)->arg(8)->arg(64);
+ @endverbatim
+ Command line options of a benchmark program:
+ --filter=text (run benchmarks whose name contains text), --min_time=seconds, --csv.
+
+ @copyright@parblock
+ Copyright (c) 2017  Carna Radojicic, Christoph Grimm, Design of Cyber-Physical Systems
+ TU Kaiserslautern Postfach 3049 67663 Kaiserslautern radojicic@cs.uni-kl.de
+
+ This file is part of AADD package.
+
+ AADD is free software: you can redistribute it and/or modify it
+ under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ AADD is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public
+ License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with AADD package. If not, see <http://www.gnu.org/licenses/>.
+ @endparblock
+ */
+
+#ifndef bench_h
+#define bench_h
+
+#include <string>
+#include <vector>
+#include <map>
+
+using namespace std;
+
+
+// number of heap allocations since program start; counted by the replaced operator new.
+unsigned long benchAllocations();
+
+
+/**
+ @brief Prevents the compiler from removing the computation of a value.
+ */
+template<class T>
+inline void doNotOptimize(const T& value)
+{
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+
+/**
+ @brief State of a running benchmark: loop control, arguments and user counters.
+ */
+class benchState
+{
+public:
+    benchState(unsigned long iterations, const vector<long>& args);
+
+    bool keepRunning();                     // true while more iterations are to be run.
+    long arg(unsigned i) const              { return args[i]; };
+    unsigned long iterations() const        { return max_iter; };
+
+    void pauseTiming();                     // excludes setup within the loop from time and allocations.
+    void resumeTiming();
+
+    void setLabel(const string& l)          { label = l; };
+    map<string, double> counters;           // reported with the results, e.g. nodes or LP calls.
+
+    // results of the run
+    double elapsed() const                  { return seconds; };
+    unsigned long allocations() const       { return allocs; };
+    const string& getLabel() const          { return label; };
+
+protected:
+    unsigned long max_iter, iter;
+    vector<long> args;
+    string label;
+
+    bool running;
+    double seconds, start;
+    unsigned long allocs, start_allocs;
+
+    void start_timer();
+    void stop_timer();
+};
+
+
+typedef void (*benchFunction)(benchState&);
+
+/**
+ @brief A registered benchmark with its argument sets.
+ */
+class benchmark
+{
+public:
+    benchmark(const string& name, benchFunction f);
+
+    benchmark* arg(long a);                 // adds a run with one argument.
+    benchmark* args(const vector<long>& a); // adds a run with several arguments.
+    benchmark* iterations(unsigned long n); // fixed number of iterations, e.g. for long scenarios.
+
+    string name;
+    benchFunction function;
+    vector<vector<long> > arg_sets;
+    unsigned long fixed_iterations;
+};
+
+benchmark* registerBenchmark(const string& name, benchFunction f);
+
+// runs the benchmarks selected by the command line; returns exit code.
+int runBenchmarks(int argc, char* argv[]);
+
+
+#define BENCH_CONCAT2(a,b) a##b
+#define BENCH_CONCAT(a,b) BENCH_CONCAT2(a,b)
+#define BENCHMARK(f) \
+    static benchmark* BENCH_CONCAT(bench_, __LINE__) = registerBenchmark(#f, f)
+
+#endif /* bench_h */
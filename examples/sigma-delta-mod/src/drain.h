@@ -7,6 +7,7 @@
 //
 
 #include "systemc-ams.h"
+#include "aadd_trace.h"
 #include <iostream>
 #include <dirent.h>
 
@@ -16,19 +17,29 @@ SCA_TDF_MODULE(drain)
 {
     sca_tdf::sca_in<T> in;
     
-    ofstream results;
+    // bounds are written by a background thread.
+    DDTraceWriter trace;
     
-    drain(sc_module_name n)
+    drain(sc_module_name n): trace("plots.bin")
     {
-        results.open("plots.txt");
     }
     
     void processing()
     {
         double time=get_time().to_seconds();
-        opt_sol min_max=in.read().GetBothBounds();
-        results << time << " " << min_max.min << " " << min_max.max << endl;
+        trace.record(time, in.read());
+    }
     
+    // converts the trace to the text file for gnuplot.
+    void end_of_simulation()
+    {
+        trace.flush();
+        vector<traceRecord> records;
+        DDTraceWriter::readTrace("plots.bin", records);
+        
+        ofstream results("plots.txt");
+        for (auto r: records)
+            results << r.time << " " << r.min << " " << r.max << endl;
     }
     
 };
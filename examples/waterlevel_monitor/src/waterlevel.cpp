@@ -1,4 +1,5 @@
 #include "aadd.h"
+#include "aadd_trace.h"
 #include "systemc-ams.h"
 
 using namespace sca_tdf;
@@ -91,20 +92,26 @@ SCA_TDF_MODULE(controller)
 SCA_TDF_MODULE(drain) 
 {
     sca_tdf::sca_in<doubleS> in;
-    ofstream plotfile;
-    
-    void initialize() {
-        plotfile.open("plots.txt");
-    }
+    DDTraceWriter trace;   // writes bounds in a background thread.
     
     void processing() {
         double time=get_time().to_seconds();
-        opt_sol input=in.read().GetBothBounds();
-        plotfile << time << " " << input.min <<  " " << input.max << " " << 1 << " " << 12 << std::endl;
+        trace.record(time, in.read());
+    }
+    
+    // Converts the trace to the text file for gnuplot.
+    void end_of_simulation() {
+        trace.flush();
+        vector<traceRecord> records;
+        DDTraceWriter::readTrace("plots.bin", records);
+        
+        ofstream plotfile("plots.txt");
+        for (auto r: records)
+            plotfile << r.time << " " << r.min <<  " " << r.max << " " << 1 << " " << 12 << std::endl;
     }
     
-    // Constructor: does nothing.
-    drain(sc_module_name n){}
+    // Constructor: opens the trace.
+    drain(sc_module_name n): trace("plots.bin") {}
 };
 
 
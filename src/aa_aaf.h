@@ -95,6 +95,7 @@ static list <AAF*> allAAF;
   AAF(double v0 = 0.0);
   AAF(double, const double *, const unsigned *, unsigned);
   AAF(const AAF &);
+  AAF(AAF &&) noexcept;
   AAF(const AAInterval);
   AAF (double, double);
 
@@ -109,16 +110,18 @@ static list <AAF*> allAAF;
   bool operator >= (const AAF &) const;
   bool operator == (const AAF &) const;
   bool operator!=(const AAF&) const;
+  bool isIdentical(const AAF &) const;
 
   AAF & operator = (const AAF &);
+  AAF & operator = (AAF &&) noexcept;
   AAF & operator = (const double);
-  AAF operator + (const AAF &) const;
-  AAF operator - (const AAF &) const;
+  AAF operator + (const AAF &) const &;
+  AAF operator - (const AAF &) const &;
   AAF operator * (const AAF &) const;
   AAF operator / (const AAF &) const;
   AAF operator ^ (const int) const;
   
-  AAF operator - () const;
+  AAF operator - () const &;
   AAF & operator += (double);
   AAF & operator -= (double);
   AAF & operator *= (double);
@@ -127,9 +130,19 @@ static list <AAF*> allAAF;
   AAF & operator -= (const AAF &);
   AAF & operator *= (const AAF &);
   AAF & operator /= (const AAF &);
-  AAF operator * (double) const;
+  AAF operator * (double) const &;
   AAF operator / (double) const;
 
+  // rvalue operators that reuse the memory of the left operand
+  AAF operator + (const AAF &) &&;
+  AAF operator - (const AAF &) &&;
+  AAF operator - () &&;
+  AAF operator * (double) &&;
+
+  // fused affine operations
+  AAF & axpy(double, const AAF &);
+  friend AAF lincomb(unsigned, const double *, const AAF * const *, double);
+
   friend std::ostream & operator << (std::ostream &, const AAF &);
   friend AAF arg(AAF &, AAF &);
   friend AAF mag(const AAF &, const AAF &);
@@ -175,10 +188,8 @@ double at(unsigned) const;
   static tApproximationType getApproximationType(void);
   static void setApproximationType(tApproximationType);
 
-#ifdef USE_AAF_EXTENSIONS
   // this method must be treaten carefully !!!
   static void setDefault(const unsigned val = 0);
-#endif
   static unsigned getDefault(void);
 #ifdef CLEANUP
   static void cleanup(double);
@@ -219,6 +230,10 @@ AAF operator / (double, const AAF);
 AAF operator + (double, const AAF);
 AAF operator - (double, const AAF);
 
+// fused affine combinations
+AAF lincomb(unsigned, const double *, const AAF * const *, double c = 0.0);
+AAF lincomb(double, const AAF &, double, const AAF &, double c = 0.0);
+
 // unary functions
 AAF sqrt(const AAF &);
 AAF isqrt(const AAF &);
@@ -314,12 +329,10 @@ inline AAF pow(const AAF & P, int exp)
  *   Input  : unsigned : highest symbol index
  *   Output : -
  ************************************************************/
-#ifdef USE_AAF_EXTENSIONS
 inline void AAF::setDefault(const unsigned val)
 {
   last = val;
 }
-#endif
 
 /************************************************************
  * Method:        getDefault
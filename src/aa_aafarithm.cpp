@@ -145,10 +145,7 @@ AAF & AAF::operator /= (double cst)
 {
 
  if (cst==0)
- {
-   std::cout << "ERROR: Division by zero!!!" << std::endl;
-   exit(1);
- }
+   throw AAF_Exception(AAF_DIVZERO_EXCEPTION, "Division by zero");
   cst = 1.0/cst;
 
   (*this)*=cst;
@@ -373,7 +370,7 @@ if (offset_min==0 and offset_max==0 and P.offset_min==0 and P.offset_max==0)
  *   Input  : const AAF : AAF to be added
  *   Output : AAF
  ************************************************************/
-AAF AAF::operator + (const AAF & P) const
+AAF AAF::operator + (const AAF & P) const &
 {
  
   unsigned l1 = length;
@@ -787,7 +784,7 @@ AAF & AAF::operator -= (const AAF & P)
  *   Output : AAF
  ************************************************************/
  
-AAF AAF::operator - (const AAF & P) const
+AAF AAF::operator - (const AAF & P) const &
 {
 
   unsigned l1 = length;
@@ -997,7 +994,7 @@ AAF AAF::operator - (const AAF & P) const
  *   Input  : const AAF : AAF to be multiplied by -1
  *   Output : AAF
  ************************************************************/
-AAF AAF::operator - () const
+AAF AAF::operator - () const &
 {
   AAF Temp(*this);
 
@@ -1027,7 +1024,7 @@ AAF AAF::operator - () const
  *   Input  : double : double to be multiplyed by
  *   Output : AAF
  ************************************************************/
-AAF AAF::operator * (double cst) const
+AAF AAF::operator * (double cst) const &
 {
   AAF Temp(*this);
  
@@ -1055,6 +1052,193 @@ AAF AAF::operator / (double cst) const
   return Temp;
 }
 
+/************************************************************
+ * Method:        axpy
+ * Description:   
+ *   Fused, in-place update *this += a*x. The deviations of x
+ *   are added in one pass; if the noise symbols of x are
+ *   already in *this, no memory is allocated.
+ *
+ *   Input  : double : factor a
+ *            AAF    : x
+ *   Output : AAF &  : *this
+ ************************************************************/
+AAF & AAF::axpy(double a, const AAF & x)
+{
+  if (a == 0 || &x == this)
+  {
+    if (a != 0) *this *= (1.0+a);
+    return (*this);
+  }
+
+  cvalue += a*x.cvalue;
+
+  double offs_min = a*x.offset_min;
+  double offs_max = a*x.offset_max;
+  if (a < 0) swap(offs_min, offs_max);
+  offset_min += offs_min;
+  offset_max += offs_max;
+
+  // length of the union of the indexes
+  unsigned ltemp = length;
+  for (unsigned i = 0, j = 0; j < x.length; j++)
+  {
+    while (i < length && indexes[i] < x.indexes[j]) i++;
+    if (i == length || indexes[i] != x.indexes[j]) ltemp++;
+  }
+
+  if (ltemp == length)
+  {
+    // all noise symbols of x are in *this; add in place.
+    for (unsigned i = 0, j = 0; j < x.length; j++)
+    {
+      while (indexes[i] < x.indexes[j]) i++;
+      deviations[i] += a*x.deviations[j];
+    }
+  }
+  else
+  {
+    unsigned * idtemp = new unsigned [ltemp];
+    double * vatemp = new double [ltemp];
+    unsigned i = 0, j = 0;
+
+    for (unsigned k = 0; k < ltemp; k++)
+    {
+      if (j == x.length || (i < length && indexes[i] < x.indexes[j]))
+      {
+        idtemp[k] = indexes[i];
+        vatemp[k] = deviations[i++];
+      }
+      else if (i == length || x.indexes[j] < indexes[i])
+      {
+        idtemp[k] = x.indexes[j];
+        vatemp[k] = a*x.deviations[j++];
+      }
+      else
+      {
+        idtemp[k] = indexes[i];
+        vatemp[k] = deviations[i++] + a*x.deviations[j++];
+      }
+    }
+
+    delete [] indexes;
+    delete [] deviations;
+    indexes = idtemp;
+    deviations = vatemp;
+    length = ltemp;
+    size = ltemp;
+  }
+
+#ifdef FAST_RAD
+  radius = 0.0;
+  for (unsigned i = 0; i < length; i++)
+    radius += fabs(deviations[i]);
+#endif
+
+  return (*this);
+}
+
+
+/************************************************************
+ * Operator:      + (rvalue)
+ * Description:   
+ *   Affine addition to a temporary; the result is computed
+ *   in the memory of the temporary. Same result as +.
+ *
+ *   Input  : const AAF : AAF to be added
+ *   Output : AAF
+ ************************************************************/
+AAF AAF::operator + (const AAF & P) &&
+{
+  if (length == 0 && P.length != 0)
+    return static_cast<const AAF &>(*this) + P;
+
+  if (length+P.length == 0)
+  {
+    offset_min = offset_max = 0;
+    cvalue += P.cvalue;
+  }
+  else if (P.length == 0)
+    cvalue += P.cvalue;
+  else
+    axpy(1.0, P);
+
+  return std::move(*this);
+}
+
+
+/************************************************************
+ * Operator:      - (rvalue)
+ * Description:   
+ *   Affine subtraction from a temporary; the result is
+ *   computed in the memory of the temporary. Same result as -.
+ *
+ *   Input  : const AAF : AAF to be subtracted
+ *   Output : AAF
+ ************************************************************/
+AAF AAF::operator - (const AAF & P) &&
+{
+  if (length == 0 && P.length != 0)
+    return static_cast<const AAF &>(*this) - P;
+
+  if (length+P.length == 0)
+  {
+    offset_min = offset_max = 0;
+    cvalue -= P.cvalue;
+  }
+  else if (P.length == 0)
+    cvalue -= P.cvalue;
+  else
+  {
+    // offsets as in operator -
+    double offs_min = offset_min - P.offset_min;
+    double offs_max = offset_max - P.offset_max;
+    axpy(-1.0, P);
+    offset_min = offs_min;
+    offset_max = offs_max;
+  }
+
+  return std::move(*this);
+}
+
+
+/************************************************************
+ * Operator:      - (rvalue)
+ * Description:   
+ *   Unary operator on a temporary, negated in place.
+ *
+ *   Output : AAF
+ ************************************************************/
+AAF AAF::operator - () &&
+{
+  cvalue = -cvalue;
+  for (unsigned i = 0; i < length; i++)
+    deviations[i] = -deviations[i];
+
+  swap(offset_min, offset_max);
+  offset_min = -offset_min;
+  offset_max = -offset_max;
+
+  return std::move(*this);
+}
+
+
+/************************************************************
+ * Operator:      * (rvalue)
+ * Description:   
+ *   Mul of a temporary by a constant, in place.
+ *
+ *   Input  : double : double to be multiplyed by
+ *   Output : AAF
+ ************************************************************/
+AAF AAF::operator * (double cst) &&
+{
+  *this *= cst;
+
+  return std::move(*this);
+}
+
+
 // -- Non member AAF functions --
 
 
@@ -1116,3 +1300,105 @@ AAF operator - (double cst, AAF P)
     
   return (Temp);
 }
+
+
+/************************************************************
+ * Function:      lincomb
+ * Description:   
+ *   Fused affine combination c + w[0]*x[0] + ... + w[n-1]*x[n-1].
+ *   The index sets of all x[i] are merged at once and the
+ *   result is written in a single pass, without temporaries.
+ *
+ *   Input  : unsigned : number of terms n
+ *            double * : weights w[0..n-1]
+ *            AAF ** : affine forms x[0..n-1]
+ *            double   : constant c
+ *   Output : AAF
+ ************************************************************/
+AAF lincomb(unsigned n, const double * w, const AAF * const * x, double c)
+{
+  AAF Temp(c);
+  unsigned total = 0;
+
+  for (unsigned i = 0; i < n; i++)
+  {
+    if (w[i] == 0) continue;
+
+    Temp.cvalue += w[i]*x[i]->cvalue;
+
+    double offs_min = w[i]*x[i]->offset_min;
+    double offs_max = w[i]*x[i]->offset_max;
+    if (w[i] < 0) swap(offs_min, offs_max);
+    Temp.offset_min += offs_min;
+    Temp.offset_max += offs_max;
+
+    total += x[i]->length;
+  }
+
+  if (total == 0)
+    return Temp;
+
+  Temp.indexes = new unsigned [total];
+  Temp.deviations = new double [total];
+
+  // position in the index array of each term
+  unsigned pos_buf[8];
+  vector<unsigned> pos_vec;
+  unsigned * pos = pos_buf;
+  if (n > 8)
+  {
+    pos_vec.resize(n);
+    pos = pos_vec.data();
+  }
+  for (unsigned i = 0; i < n; i++)
+    pos[i] = 0;
+
+  unsigned ltemp = 0;
+  for (;;)
+  {
+    // next index is the smallest current index of the terms
+    unsigned id = ~0u;
+    for (unsigned i = 0; i < n; i++)
+      if (w[i] != 0 && pos[i] < x[i]->length && x[i]->indexes[pos[i]] < id)
+        id = x[i]->indexes[pos[i]];
+
+    if (id == ~0u)
+      break;
+
+    double dev = 0.0;
+    for (unsigned i = 0; i < n; i++)
+      if (w[i] != 0 && pos[i] < x[i]->length && x[i]->indexes[pos[i]] == id)
+        dev += w[i]*x[i]->deviations[pos[i]++];
+
+    Temp.indexes[ltemp] = id;
+    Temp.deviations[ltemp] = dev;
+#ifdef FAST_RAD
+    Temp.radius += fabs(dev);
+#endif
+    ltemp++;
+  }
+
+  Temp.length = ltemp;
+  Temp.size = ltemp;
+
+  return Temp;
+}
+
+
+/************************************************************
+ * Function:      lincomb
+ * Description:   
+ *   Fused affine combination a*x + b*y + c.
+ *
+ *   Input  : double, AAF : a, x
+ *            double, AAF : b, y
+ *            double      : c
+ *   Output : AAF
+ ************************************************************/
+AAF lincomb(double a, const AAF & x, double b, const AAF & y, double c)
+{
+  double w[2] = {a, b};
+  const AAF * t[2] = {&x, &y};
+
+  return lincomb(2, w, t, c);
+}
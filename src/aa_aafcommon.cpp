@@ -28,6 +28,7 @@
 // }}} 
 
 #include "aa.h"
+#include "aadd_stats.h"
 
 #include <cmath>
 #include <iostream>
@@ -67,6 +68,7 @@ AAF::AAF(double v0):
   offset_min(0),
   offset_max(0)
 {
+  AADD_STAT_INC(aaf_allocs);
 #ifdef CLEANUP
   allAAF.push_back(this);
 #endif
@@ -109,6 +111,8 @@ AAF::AAF(double v0, const double * t1, const unsigned * t2, unsigned T):
 
   if (indexes[length-1] > last) 
     last = indexes[length-1];
+  AADD_STAT_INC(aaf_allocs);
+  AADD_STAT_LENGTH(length);
 #ifdef CLEANUP
   allAAF.push_back(this);
 #endif
@@ -152,6 +156,8 @@ AAF::AAF(const AAF &P):
     indexes[i] = P.indexes[i];
   }
 
+  AADD_STAT_INC(aaf_allocs);
+  AADD_STAT_LENGTH(length);
 #ifdef CLEANUP
   allAAF.push_back(this);
 #endif
@@ -159,6 +165,36 @@ AAF::AAF(const AAF &P):
 }
 
 
+/************************************************************
+ * Method:        AAF
+ * Description:   
+ *   Move constructor; takes over the arrays of P
+ *
+ *   Input  : AAF : AAF to be moved
+ *   Output : -
+ ************************************************************/
+AAF::AAF(AAF &&P) noexcept:
+  cvalue(P.cvalue), 
+  length(P.length),
+  size(P.size),
+#ifdef FAST_RAD
+  radius(P.radius),
+#endif 
+  deviations(P.deviations),
+  indexes(P.indexes),
+  offset_min(P.offset_min),
+  offset_max(P.offset_max)
+{
+  P.deviations = NULL;
+  P.indexes = NULL;
+  P.length = P.size = 0;
+
+#ifdef CLEANUP
+  allAAF.push_back(this);
+#endif
+}
+
+
 /************************************************************
  * Method:        AAF
  * Author & Date: ??? - ???
@@ -188,6 +224,7 @@ AAF::AAF(const AAInterval iv):
   radius = fabs(deviations[0]);
 #endif
 
+  AADD_STAT_INC(aaf_allocs);
 #ifdef CLEANUP
   allAAF.push_back(this);
 #endif
@@ -224,6 +261,7 @@ offset_max(0)
     radius = fabs(deviations[0]);
 #endif
     
+    AADD_STAT_INC(aaf_allocs);
 #ifdef CLEANUP
     allAAF.push_back(this);
 #endif
@@ -317,6 +355,7 @@ AAF & AAF::operator = (const AAF & P)
                 deviations = new double [size];
                 indexes = new unsigned [size];
             }
+            AADD_STAT_LENGTH(size);
         }
         
         cvalue = P.cvalue;
@@ -339,6 +378,35 @@ AAF & AAF::operator = (const AAF & P)
      return *this;
 }
 
+/************************************************************
+ * Method:        =
+ * Description:   
+ *   Move assignment; exchanges the arrays with P
+ *
+ *   Input  : AAF
+ *   Output : -
+ ************************************************************/
+AAF & AAF::operator = (AAF && P) noexcept
+{
+    if (&P != this)
+    {
+        std::swap(deviations, P.deviations);
+        std::swap(indexes, P.indexes);
+        std::swap(size, P.size);
+
+        cvalue = P.cvalue;
+        length = P.length;
+        offset_min=P.offset_min;
+        offset_max=P.offset_max;
+#ifdef FAST_RAD
+        radius = P.radius;
+#endif
+        P.length = 0;
+    }
+
+    return *this;
+}
+
 /************************************************************
  * Method:        <
  * Author & Date: ??? - ???
@@ -462,6 +530,35 @@ bool AAF::operator != (const AAF & P) const
 
 }
 
+/************************************************************
+ * Method:        isIdentical
+ * Author & Date: ??? - ???
+ * Description:
+ *   Compare if two affine expressions are exactly the same,
+ *   including their offsets; unlike ==, without a tolerance.
+ *
+ *   Input  : AAF
+ *   Output : -
+ ************************************************************/
+bool AAF::isIdentical(const AAF & P) const
+{
+  if (length != P.length || cvalue != P.cvalue ||
+      offset_min != P.offset_min || offset_max != P.offset_max)
+  {
+    return false;
+  }
+
+  for (unsigned i = 0; i < length; i++)
+  {
+    if (deviations[i] != P.deviations[i] || indexes[i] != P.indexes[i])
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
 
 
 
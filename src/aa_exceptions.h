@@ -32,6 +32,9 @@
 #define AAF_DIVZERO_EXCEPTION   1
 #define AAF_NEGROOT_EXCEPTION   2
 #define AAF_NEGLOG_EXCEPTION    3
+#define AADD_SYNTAX_EXCEPTION   4
+#define AADD_RANGE_EXCEPTION    5
+#define AADD_LOOP_EXCEPTION     6
 
 #include <string>
 #include <exception>
@@ -48,6 +48,9 @@ class AADDNode;
 typedef AADDNode* (*AADD_AOP)(AADDNode *,AADDNode *);
 typedef AADDNode* (*AADD_AOPC)(AADDNode*, const AAF &);
 typedef AADDNode* (*AADD_UOP)(AADDNode*);
+typedef AAF (*AADD_NOP)(const vector<AAF>&);
+
+template<class E> class aaddExpr;   // expression templates in aadd_expr.h
 
 
 /**
@@ -59,6 +62,7 @@ class AADDNode: public DDNode<AAF>
 public: 
     // AADDNode();
     AADDNode(const AAF&);
+    AADDNode(AAF&&);
     AADDNode(const AADDNode& source); // copy constructor
     AADDNode(const unsigned long index, AADDNode* T, AADDNode* F);
     
@@ -92,6 +96,7 @@ class AADD: public DDBase<AAF>
     AADD& assign(const AADD& right);
     AADD(const AADD& from);
     AADD(const AADDNode& from);
+    template<class E> AADD(const aaddExpr<E>&);   // see aadd_expr.h
 
     
     // destructor
@@ -99,6 +104,7 @@ class AADD: public DDBase<AAF>
     
     // Assigment operators
     AADD& operator=(const AADD& right);
+    template<class E> AADD& operator=(const aaddExpr<E>&);   // see aadd_expr.h
     
     // Relational operators    
     BDD& operator<=(const AADD&) const;
@@ -138,6 +144,7 @@ class AADD: public DDBase<AAF>
     AADDNode* ApplyBinOp(AADD_AOP op, AADDNode* f, AADDNode* g) const;
     AADDNode* ApplyBinOpC(AADD_AOPC op, AADDNode* f, const AAF& g) const;
     AADDNode* ApplyUnaryOp(AADD_UOP op, AADDNode* f) const;
+    AADDNode* ApplyNaryOp(AADD_NOP op, const vector<AADDNode*>& f) const;
     AADDNode* BTimesA(BDDNode* f, AADDNode* g) const; 
     AADDNode* Join(AADDNode* f, vector<constraint<AAF> >) const;
     
@@ -151,13 +158,24 @@ class AADD: public DDBase<AAF>
     vector<AAF> getConds() const;
     void printConds() const;
 
+    // concrete evaluation at given values of the noise symbols
+    double Evaluate(const double* eps, unsigned K) const;
+    vector<double> Evaluate(const double* samples, unsigned M, unsigned K) const;
+
     // printing AADD to stream s, default is cout
     void print(std::ostream & s=std::cout) const;
 
     // printing AADD to the file format recognised by graph drawing program Graphviz
     int printf(string file_name) const;
+
+    // saving and loading AADD in a binary format
+    int save(string file_name) const;
+    int load(string file_name);
     
   protected:
+    // Assignment of the root of a new tree, as assign, but without copying it.
+    AADD& assignRoot(AADDNode* result);
+
     // Called by relational operators
     BDDNode* Compare(AADDNode*, double, vector<constraint<AAF> >, string) const;
     
@@ -192,6 +210,19 @@ AADD& operator / (const BDD&, const AADD&);
 AADD& operator + (const BDD&, const AADD&);
 AADD& operator - (const BDD&, const AADD&);
 
+// N-ary operations that combine several AADD in one traversal.
+AADD& apply(AADD_NOP op, const vector<const AADD*>& args);
+AADD& apply(AADD_NOP op, const vector<AADD>& args);
+AADD& sum(const vector<const AADD*>& args);
+AADD& sum(const vector<AADD>& args);
+
+// Bounds of a leaf under the conditions of its path, cached in the leaf.
+opt_sol solve_lp(const AADDNode& leaf, const vector<constraint<AAF> >& constraints);
+
+// Bounds of several AADD that share their conditions, with one LP per path.
+vector<opt_sol> GetBothBounds(const vector<const AADD*>& vars);
+vector<opt_sol> GetBothBounds(const vector<AADD>& vars);
+
 // Operations on AADDNodes for internal use:
 AADDNode* Times(AADDNode*, AADDNode*);
 AADDNode* Divide(AADDNode*, AADDNode*);
@@ -203,6 +234,8 @@ AADDNode* DivideC(AADDNode*, const AAF&);
 AADDNode* PlusC(AADDNode*, const AAF&);
 AADDNode* MinusC(AADDNode*, const AAF&);
 
+AAF Sum(const vector<AAF>&);
+
 
 // For IO
 std::ostream & operator << (std::ostream & s, const AADD& f);
@@ -217,6 +250,8 @@ typedef class AADD realS;
 typedef class BDD  boolS;
 
 #include "aadd_mgr.h"
+#include "aadd_profile.h"
+#include "aadd_loop.h"
 #include "aadd_macros.h"
 
 #endif /* aadd_h */
@@ -77,10 +77,7 @@ AADDNode* Floor(AADDNode* f)
         if (value.getlength()==0)
             value=floor(f->getValue().getcenter());
         else
-        {
-            cout << "Operation on ranges not defined!" << endl;
-            exit(1);
-        }
+            throw AADD_Exception(AADD_RANGE_EXCEPTION, "floor: operation on ranges not defined");
         
         res = new AADDNode(value);
         return(res);
@@ -97,15 +94,9 @@ AADDNode* Floor(AADDNode* f)
  */
 AADDNode* Inv(AADDNode* f)
 {
-    AADDNode *res;
-    
-    AAF value;
-    
     /* Check terminal cases. */
     if (f->isLeaf() ) {
-        value=inv(f->getValue());
-        res = new AADDNode(value);
-        return(res);
+        return(new AADDNode(inv(f->getValue())));
     }
     return NULL;
 }
@@ -173,26 +164,16 @@ AADD& abs(const AADD& g)
  */
 AADDNode* Times(AADDNode* f, AADDNode* g)
 {
-    AADDNode *res;
-    AAF value;
-    
     if (f->isLeaf() && g->isLeaf()) {
-        value= f->getValue()*g->getValue();
-        res = new AADDNode(value);
-        return(res);
+        return(new AADDNode(f->getValue()*g->getValue()));
     }
     return(nullptr);
 }
 
 AADDNode* TimesC(AADDNode* f, const AAF& g)
 {
-    AADDNode *res;
-    AAF value;
-    
     if (f->isLeaf()) {
-        value=f->getValue()*g;
-        res = new AADDNode(value);
-        return(res);
+        return(new AADDNode(f->getValue()*g));
     }
     return(nullptr);
 }
@@ -207,24 +188,16 @@ AADDNode* TimesC(AADDNode* f, const AAF& g)
  */
 AADDNode* Divide(AADDNode* f, AADDNode* g)
 {
-    AADDNode *res;
-    AAF value;
-    
     if (f-> isLeaf() && g->isLeaf() ) {
-        value = f->getValue()/g->getValue();
-        res = new AADDNode(value);
-        return(res);
+        return(new AADDNode(f->getValue()/g->getValue()));
     }
     return(nullptr);
 }
 
 AADDNode* DivideC(AADDNode* f, const AAF& g)
 {
-    AAF value;
-
     if (f->isLeaf()) {
-        value = (f->getValue())/g;
-        return(new AADDNode(value));
+        return(new AADDNode(f->getValue()/g));
     }
     return(nullptr);
 }
@@ -239,8 +212,7 @@ AADDNode* DivideC(AADDNode* f, const AAF& g)
 AADDNode* Plus(AADDNode* f, AADDNode* g)
 {
     if (f->isLeaf() && g->isLeaf() ) {
-        AAF value=f->getValue()+g->getValue();
-        return(new AADDNode(value));
+        return(new AADDNode(f->getValue()+g->getValue()));
     }
     return(nullptr);
 }
@@ -248,8 +220,7 @@ AADDNode* Plus(AADDNode* f, AADDNode* g)
 AADDNode* PlusC(AADDNode* f, const AAF& g)
 {
     if (f->isLeaf() ) {
-        AAF value=f->getValue()+g;
-        return(new AADDNode(value));
+        return(new AADDNode(f->getValue()+g));
     }
     return(nullptr);
 }
@@ -264,8 +235,7 @@ AADDNode* PlusC(AADDNode* f, const AAF& g)
 AADDNode* Minus(AADDNode* f, AADDNode* g)
 {
     if ( f->isLeaf() && g->isLeaf() ) {
-        AAF value= f->getValue()- g->getValue();
-        return(new AADDNode(value));
+        return(new AADDNode(f->getValue()- g->getValue()));
     }
     return(NULL);
     
@@ -273,11 +243,8 @@ AADDNode* Minus(AADDNode* f, AADDNode* g)
 
 AADDNode* MinusC(AADDNode* f, const AAF& g)
 {
-    AAF value;
-    
     if (f->isLeaf() ) {
-        value= f->getValue()-g;
-        return(new AADDNode(value));
+        return(new AADDNode(f->getValue()-g));
     }
     return(nullptr);
 }
@@ -313,6 +280,7 @@ AADDNode* AADD::ApplyUnaryOp(AADD_UOP op, AADDNode* f) const
     
     unsigned long index;
     
+    AADD_STAT_INC(apply_calls);
     res = (*op)(f);
     if (res != nullptr) return(res);
     
@@ -369,6 +337,7 @@ AADDNode* AADD::ApplyBinOp(AADD_AOP op, AADDNode*f, AADDNode* g) const
     unsigned long index;
     
     /* Check terminal cases */
+    AADD_STAT_INC(apply_calls);
     res = (*op)(f,g);
     if (res != nullptr) return(res);
     
@@ -423,6 +392,7 @@ AADDNode* AADD::ApplyBinOpC(AADD_AOPC op, AADDNode*f, const AAF& cst) const
 {
     AADDNode *res, *fv, *fvn, *T, *E;
     
+    AADD_STAT_INC(apply_calls);
     res = (*op)(f, cst);
     
     if (res != nullptr) return(res);
@@ -458,6 +428,123 @@ AADDNode* AADD::ApplyBinOpC(AADD_AOPC op, AADDNode*f, const AAF& cst) const
     return(res);
 }
 
+/**
+ @brief Recursion of ApplyNaryOp.
+ @details The current nodes of the k operands are stack[base .. base+k-1]; the nodes of the
+ children are pushed above them. vals is reused for the values of the leaves.
+ */
+static AADDNode* ApplyNary(AADD_NOP op, vector<AADDNode*>& stack, size_t base, unsigned k, vector<AAF>& vals)
+{
+    unsigned long index = MAXINDEX;
+
+    AADD_STAT_INC(apply_calls);
+    for (unsigned i=0; i < k; i++)
+        if (stack[base+i]->getIndex() < index) index = stack[base+i]->getIndex();
+
+    /* Terminal case: all operands are leaves. */
+    if (index == MAXINDEX)
+    {
+        for (unsigned i=0; i < k; i++) vals[i] = stack[base+i]->getValue();
+        return new AADDNode((*op)(vals));
+    }
+
+    /* Recursive step; operands with other index are kept. */
+    size_t top = base+k;
+    stack.resize(top+k);
+    for (unsigned i=0; i < k; i++)
+    {
+        AADDNode* f = stack[base+i];
+        stack[top+i] = (f->getIndex() == index) ? f->getT() : f;
+    }
+    AADDNode* T = ApplyNary(op, stack, top, k, vals);
+
+    stack.resize(top+k);
+    for (unsigned i=0; i < k; i++)
+    {
+        AADDNode* f = stack[base+i];
+        stack[top+i] = (f->getIndex() == index) ? f->getF() : f;
+    }
+    AADDNode* E = ApplyNary(op, stack, top, k, vals);
+
+    // Maybe we can reduce?
+    if (T->isLeaf() and E->isLeaf() and T->getValue()==E->getValue())
+    {
+        delete E;
+        return T;
+    }
+    return new AADDNode(index, T, E);
+}
+
+
+/**
+ @brief Method called by n-ary operations such as sum.
+ @details Traverses the k diagrams with roots f[0..k-1] simultaneously, always descending at the
+ smallest index of the current nodes as ApplyBinOp. At each leaf of the result, op is called once
+ with the k values of the leaves reached in the operands.
+ @return the root of AADD
+ */
+AADDNode* AADD::ApplyNaryOp(AADD_NOP op, const vector<AADDNode*>& f) const
+{
+    unsigned k = f.size();
+    vector<AADDNode*> stack(f);
+    vector<AAF> vals(k);
+
+    stack.reserve(4*k);
+    return ApplyNary(op, stack, 0, k, vals);
+}
+
+
+/**
+ @brief Public method that combines the AADD args in one traversal.
+ @details op receives the values of the leaves of all args, in the order of args.
+ @return AADD
+ */
+AADD& apply(AADD_NOP op, const vector<const AADD*>& args)
+{
+    vector<AADDNode*> roots;
+    for (unsigned i=0; i < args.size(); i++) roots.push_back(args[i]->getRoot());
+
+    AADD* Temp=new AADD;
+    Temp->setRoot(Temp->ApplyNaryOp(op, roots));
+    return (*Temp);
+}
+
+AADD& apply(AADD_NOP op, const vector<AADD>& args)
+{
+    vector<const AADD*> ptrs;
+    for (unsigned i=0; i < args.size(); i++) ptrs.push_back(&args[i]);
+    return apply(op, ptrs);
+}
+
+
+/**
+ @brief Function called by sum on the leaves; adds the values with one fused affine combination.
+ */
+AAF Sum(const vector<AAF>& vals)
+{
+    static thread_local vector<double> w;
+    static thread_local vector<const AAF*> x;
+    w.assign(vals.size(), 1.0);
+    x.resize(vals.size());
+    for (unsigned i=0; i < vals.size(); i++) x[i] = &vals[i];
+    return lincomb(vals.size(), w.data(), x.data());
+}
+
+/**
+ @brief Public method that performs args[0]+ ... +args[k-1] in one traversal.
+ @return AADD
+ */
+AADD& sum(const vector<const AADD*>& args)
+{
+    return apply(Sum, args);
+}
+
+AADD& sum(const vector<AADD>& args)
+{
+    return apply(Sum, args);
+}
+
+
 /**
  @brief Private method called by binary operators (*, +, -, /)
  @details Called recursively until all terminal vertices are reached
@@ -741,10 +828,7 @@ AADDNode* AADD::Modulo(AADDNode* f, int cst) const
     
     F = f;
     if (cst==0)
-    {
-        cout << "Error: Remainder by ZERO is undefined!" << endl;
-        exit(1);
-    }
+        throw AADD_Exception(AAF_DIVZERO_EXCEPTION, "%: remainder by zero is undefined");
     
     if (F->isLeaf() ) {
         
@@ -753,10 +837,7 @@ AADDNode* AADD::Modulo(AADDNode* f, int cst) const
             value=((int)((F->getValue()).getcenter()))%cst;
         }
         else
-        {
-            cout << "Error: Remainder not defined on ranges!" << endl;
-            exit(1);
-        }
+            throw AADD_Exception(AADD_RANGE_EXCEPTION, "%: remainder not defined on ranges");
         
         res = new AADDNode(value);
         return(res);
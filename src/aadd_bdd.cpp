@@ -111,7 +111,7 @@ BDD::~BDD()
  @brief Copy constructor
  @author Carna Radojicic, Christoph Grimm
  */
-BDD::BDD(const BDD &from)
+BDD::BDD(const BDD &from): DDBase<bool>()
 {
     if (from.root->isLeaf())
     {
@@ -217,7 +217,9 @@ BDD& BDD::assign(const BDD& right)
         copy = new BDDNode( *right.getRoot() );
     
     if (bCond().inCond() ){
+        profiler().beginAssign(numLeaves());
         ITE(bCond().blockCondition(), copy, *this);
+        profiler().endAssign(numLeaves());
     }
     else {
         root->delete_tree();
@@ -112,6 +112,14 @@ public:
     // Prints BDD to stream s
     void print(std::ostream & s) const;
 
+    // saving and loading BDD in a binary format
+    int save(string file_name) const;
+    int load(string file_name);
+
+    // concrete evaluation at given values of the noise symbols
+    bool Evaluate(const double* eps, unsigned K) const;
+    vector<bool> Evaluate(const double* samples, unsigned M, unsigned K) const;
+
     BDD(bool = false);
     BDD(int);
     BDD(const BDD& from);
@@ -0,0 +1,215 @@
+/**
+
+ @file aadd_box.cpp
+
+ @ingroup AADD
+
+ @brief Boxes of the noise symbols that are contracted by the path conditions.
+
+ @copyright@parblock
+ Copyright (c) 2017  Carna Radojicic, Christoph Grimm, Design of Cyber-Physical Systems
+ TU Kaiserslautern Postfach 3049 67663 Kaiserslautern radojicic@cs.uni-kl.de
+
+ This file is part of AADD package.
+
+ AADD is free software: you can redistribute it and/or modify it
+ under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ AADD is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public
+ License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with AADD package. If not, see <http://www.gnu.org/licenses/>.
+ @endparblock
+ */
+
+#include <assert.h>
+#include <math.h>
+
+#include "aadd_box.h"
+#include "aa_rounding.h"
+
+// a bound is only changed if it improves by more than this, relative to the width 2.
+static const double MIN_CHANGE = 1e-9;
+
+
+NoiseBox::NoiseBox(unsigned p)
+{
+    passes = p;
+    empty = false;
+}
+
+
+void NoiseBox::reset()
+{
+    lo.clear();
+    hi.clear();
+    trail.clear();
+    row_start.clear();
+    row_symbol.clear();
+    row_coef.clear();
+    rhs.clear();
+    level.clear();
+    was_empty.clear();
+    empty = false;
+}
+
+
+/**
+ @brief Sets the interval of a symbol and records its old one.
+ */
+void NoiseBox::set(unsigned symbol, double l, double h)
+{
+    if (symbol >= lo.size())
+    {
+        lo.resize(symbol+1, -1.0);
+        hi.resize(symbol+1, 1.0);
+    }
+    change c = { symbol, lo[symbol], hi[symbol] };
+    trail.push_back(c);
+    lo[symbol] = l;
+    hi[symbol] = h;
+    if (l > h) empty = true;
+}
+
+
+/**
+ @brief Projects the row g'e <= rhs onto each of its symbols.
+ @details With S the minimum of g'e in the box, rounded down, each g_j e_j is at most
+ rhs - S + min(g_j e_j), rounded up. If S > rhs, the row cannot hold.
+ */
+bool NoiseBox::revise(unsigned row)
+{
+    const unsigned begin = row_start[row];
+    const unsigned end = row+1 < row_start.size() ? row_start[row+1] : row_symbol.size();
+    const double r = rhs[row];
+    bool changed = false;
+    aa_rnd_t mode = aa_fegetround();
+
+    aa_fesetround(AA_DOWNWARD);
+    double S = 0.0;
+    for (unsigned k=begin; k < end; k++)
+    {
+        const double g = row_coef[k];
+        S += g > 0 ? g*lower(row_symbol[k]) : g*upper(row_symbol[k]);
+    }
+    if (S > r)
+    {
+        aa_fesetround(mode);
+        empty = true;
+        return true;
+    }
+
+    aa_fesetround(AA_UPWARD);
+    const double slack = r-S;
+    for (unsigned k=begin; k < end and !empty; k++)
+    {
+        const unsigned j = row_symbol[k];
+        const double g = row_coef[k];
+        double l = lower(j), h = upper(j);
+
+        if (g > 0)
+        {
+            double u = (slack+g*l)/g;
+            if (u < h-MIN_CHANGE) { set(j, l, u); changed = true; }
+        }
+        else
+        {
+            double v = -((slack+g*h)/(-g));      // (slack+g*h)/g, rounded down
+            if (v > l+MIN_CHANGE) { set(j, v, h); changed = true; }
+        }
+    }
+    aa_fesetround(mode);
+    return changed;
+}
+
+
+/**
+ @brief Contracts the box by the condition con >= 0 (sign '+') or con <= 0 (sign '-').
+ @details The new row is projected first; if that changes the box, all rows are propagated
+ for at most passes rounds.
+ @return false if the box is empty, i.e. the conditions of the path cannot hold.
+ */
+bool NoiseBox::push(const AAF& con, char sign)
+{
+    level.push_back(trail.size());
+    was_empty.push_back(empty);
+
+    const double s = sign == '-' ? 1.0 : -1.0;
+    const unsigned* id = con.getIndexes();
+    row_start.push_back(row_symbol.size());
+    for (unsigned k=0; k < con.getlength(); k++)
+    {
+        if (con[k+1] == 0.0) continue;
+        row_symbol.push_back(id[k]);
+        row_coef.push_back(s*con[k+1]);
+    }
+
+    // -(center+offset_min) resp. center+offset_max, rounded up.
+    aa_rnd_t mode = aa_fegetround();
+    aa_fesetround(AA_UPWARD);
+    rhs.push_back(s > 0 ? (-con.getcenter())+(-con.offset_min) : con.getcenter()+con.offset_max);
+    aa_fesetround(mode);
+
+    if (empty) return false;
+    bool changed = revise(rhs.size()-1);
+    for (unsigned p=0; p < passes and changed and !empty; p++)
+    {
+        changed = false;
+        for (unsigned row=0; row < rhs.size() and !empty; row++)
+            if (revise(row)) changed = true;
+    }
+    return !empty;
+}
+
+
+void NoiseBox::pop()
+{
+    assert(!level.empty());
+    while (trail.size() > level.back())
+    {
+        const change& c = trail.back();
+        lo[c.symbol] = c.lo;
+        hi[c.symbol] = c.hi;
+        trail.pop_back();
+    }
+    empty = was_empty.back();
+    row_symbol.resize(row_start.back());
+    row_coef.resize(row_start.back());
+    row_start.pop_back();
+    rhs.pop_back();
+    level.pop_back();
+    was_empty.pop_back();
+}
+
+
+/**
+ @brief Range of a in the box, with outward rounding and the offsets of a.
+ */
+void NoiseBox::bounds(const AAF& a, double& min, double& max) const
+{
+    const unsigned* id = a.getIndexes();
+    aa_rnd_t mode = aa_fegetround();
+
+    aa_fesetround(AA_DOWNWARD);
+    min = a.getcenter()+a.offset_min;
+    for (unsigned k=0; k < a.getlength(); k++)
+        min += a[k+1] > 0 ? a[k+1]*lower(id[k]) : a[k+1]*upper(id[k]);
+
+    aa_fesetround(AA_UPWARD);
+    max = a.getcenter()+a.offset_max;
+    for (unsigned k=0; k < a.getlength(); k++)
+        max += a[k+1] > 0 ? a[k+1]*upper(id[k]) : a[k+1]*lower(id[k]);
+    aa_fesetround(mode);
+}
+
+
+NoiseBox& noiseBox()
+{
+    static thread_local NoiseBox box;
+    return box;
+}
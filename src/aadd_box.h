@@ -0,0 +1,96 @@
+/**
+
+ @file aadd_box.h
+
+ @ingroup AADD
+
+ @brief Boxes of the noise symbols that are contracted by the path conditions.
+
+ @details The conditions on a path of an AADD restrict the noise symbols, which are in [-1,1]
+ initially. NoiseBox keeps an interval for each symbol and contracts it by the conditions,
+ HC4-like: each affine condition is projected onto each of its symbols, and the conditions
+ are propagated until the box does not change much. With the box, the bounds of a leaf can be
+ estimated without an LP, and paths whose conditions cannot hold can be pruned.
+ @details The box is a stack: push contracts it by the condition of a node, pop restores it.
+ Only changed bounds are recorded, so that the boxes of all nodes on a path take little
+ memory. All bounds are computed with outward rounding; an empty box proves that the LP of the
+ path is infeasible.
+
+ @copyright@parblock
+ Copyright (c) 2017  Carna Radojicic, Christoph Grimm, Design of Cyber-Physical Systems
+ TU Kaiserslautern Postfach 3049 67663 Kaiserslautern radojicic@cs.uni-kl.de
+
+ This file is part of AADD package.
+
+ AADD is free software: you can redistribute it and/or modify it
+ under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ AADD is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public
+ License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with AADD package. If not, see <http://www.gnu.org/licenses/>.
+ @endparblock
+ */
+
+#ifndef aadd_box_h
+#define aadd_box_h
+
+#include <vector>
+
+#include "aa.h"
+
+using namespace std;
+
+
+/**
+ @brief Intervals of the noise symbols under the conditions of a path.
+ @details A condition with sign '+' is con >= 0, one with sign '-' is con <= 0, with the
+ offsets of con as in solve_lp.
+ */
+class NoiseBox
+{
+public:
+    NoiseBox(unsigned passes=3);
+
+    void reset();                              // all symbols in [-1,1], no conditions.
+    bool push(const AAF& con, char sign);      // contracts by a condition; false if empty.
+    void pop();                                // removes the last condition.
+
+    bool isEmpty() const                       { return empty; };
+    unsigned numConds() const                  { return rhs.size(); };
+    double lower(unsigned symbol) const        { return symbol < lo.size() ? lo[symbol] : -1.0; };
+    double upper(unsigned symbol) const        { return symbol < hi.size() ? hi[symbol] : 1.0; };
+    void bounds(const AAF& a, double& min, double& max) const;  // range of a in the box.
+
+protected:
+    // a changed bound, to restore it by pop.
+    struct change
+    {
+        unsigned symbol;
+        double lo, hi;
+    };
+
+    vector<double> lo, hi;          // intervals of the symbols; [-1,1] beyond their size
+    vector<change> trail;           // old bounds of the symbols changed
+    vector<unsigned> row_start;     // conditions as rows g'e <= rhs
+    vector<unsigned> row_symbol;
+    vector<double> row_coef;
+    vector<double> rhs;
+    vector<size_t> level;           // size of trail at each push
+    vector<bool> was_empty;         // empty before each push
+    unsigned passes;                // maximum number of propagations over all rows
+    bool empty;
+
+    bool revise(unsigned row);      // contracts by a row; true if a bound changed.
+    void set(unsigned symbol, double l, double h);
+};
+
+
+NoiseBox& noiseBox();               // the box of FindBounds and Compare; one per thread.
+
+#endif /* aadd_box_h */
@@ -0,0 +1,235 @@
+/**
+
+ @file aadd_checkpoint.cpp
+
+ @ingroup AADD
+
+ @brief Checkpoint and restore of the state of a symbolic simulation; implementation.
+
+ @details A checkpoint follows the header of the binary format:
+ @verbatim
+   checkpoint := 'C' ncond {form} last in_if nblock {record} nvar {name record}
+   name       := length {char}
+ @endverbatim
+ The records of block conditions and variables do not contain conditions; they refer
+ to the conditions of the checkpoint by their index.
+
+ @copyright@parblock
+ Copyright (c) 2017  Carna Radojicic, Christoph Grimm, Design of Cyber-Physical Systems
+ TU Kaiserslautern Postfach 3049 67663 Kaiserslautern radojicic@cs.uni-kl.de
+
+ This file is part of AADD package.
+
+ AADD is free software: you can redistribute it and/or modify it
+ under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ AADD is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public
+ License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with AADD package. If not, see <http://www.gnu.org/licenses/>.
+ @endparblock
+ */
+
+#include <fstream>
+
+#include "aadd_checkpoint.h"
+
+
+/**
+ @brief Returns the position of the variable with the given name, or -1.
+ */
+int DDCheckpoint::find(const string& name) const
+{
+    for (unsigned v=0; v < vars.size(); v++)
+        if (vars[v].name == name) return v;
+    return -1;
+}
+
+/**
+ @brief Registers an AADD variable; a variable with the same name is replaced.
+ */
+void DDCheckpoint::add(const string& name, AADD& var)
+{
+    remove(name);
+    variable v = { name, &var, nullptr };
+    vars.push_back(v);
+}
+
+/**
+ @brief Registers a BDD variable; a variable with the same name is replaced.
+ */
+void DDCheckpoint::add(const string& name, BDD& var)
+{
+    remove(name);
+    variable v = { name, nullptr, &var };
+    vars.push_back(v);
+}
+
+void DDCheckpoint::remove(const string& name)
+{
+    int v = find(name);
+    if (v >= 0) vars.erase(vars.begin()+v);
+}
+
+
+/**
+ @brief Writes the checkpoint, including the header of the format, to s.
+ */
+void DDCheckpoint::save(std::ostream& s) const
+{
+    DDWriter w(s);
+    FrozenDD f;
+
+    w.putByte('C');
+    w.putVarint(condMgr().size());
+    for (unsigned long c=0; c < condMgr().size(); c++)
+        w.putAAF(condMgr().getCond(c));
+    w.putVarint(AAF::getDefault());
+
+    w.putByte(bCond().in_if ? 1 : 0);
+    w.putVarint(bCond().conditions.size());
+    for (unsigned b=0; b < bCond().conditions.size(); b++)
+    {
+        f.freeze(*bCond().conditions[b]);
+        w.write(f, false);
+    }
+
+    w.putVarint(vars.size());
+    for (unsigned v=0; v < vars.size(); v++)
+    {
+        w.putVarint(vars[v].name.size());
+        for (unsigned i=0; i < vars[v].name.size(); i++)
+            w.putByte(vars[v].name[i]);
+
+        if (vars[v].aadd != nullptr) f.freeze(*vars[v].aadd);
+        else f.freeze(*vars[v].bdd);
+        w.write(f, false);
+    }
+}
+
+/**
+ @brief Saves the checkpoint to a file.
+ @return 0 if no error or 1 in case of error
+ */
+int DDCheckpoint::save(string file_name) const
+{
+    std::ofstream s(file_name.c_str(), std::ios::binary);
+    save(s);
+    s.close();
+    return s.fail() ? 1 : 0;
+}
+
+
+/**
+ @brief Restores the state from a checkpoint in a memory buffer.
+ @details The data is checked completely before the state is changed. All registered
+ variables must be in the checkpoint; variables of the checkpoint that are not registered
+ are ignored. Other diagrams are invalid afterwards; see aadd_checkpoint.h.
+ @return true if successful; otherwise, or if called in a conditional statement or loop,
+ the state is not changed.
+ */
+bool DDCheckpoint::restore(const unsigned char* data, size_t size)
+{
+    if (bCond().inCond()) return false;
+
+    DDReader r(data, size);
+    if (r.getByte() != 'C') return false;
+
+    unsigned long ncond = r.getVarint();
+    vector<AAF> conds;
+    for (unsigned long c=0; c < ncond and !r.failed(); c++)
+        conds.push_back(r.getAAF());
+    unsigned last = r.getVarint();
+    if (r.failed()) return false;
+
+    // the records refer to the conditions of the checkpoint; they are checked against
+    // condMgr(), hence we install them first and roll back in case of error.
+    condMgrC old_conds;
+    condMgr().swapConditions(old_conds);
+    for (unsigned long c=0; c < conds.size(); c++)
+        condMgr().addCond(conds[c]);
+
+    bool in_if = (r.getByte() != 0);
+    unsigned long nblock = r.getVarint();
+    vector<FrozenDD> blocks;
+    for (unsigned long b=0; b < nblock and !r.failed(); b++)
+    {
+        blocks.push_back(FrozenDD());
+        if (!r.read(blocks.back(), false) or !blocks.back().isBDD()) break;
+    }
+
+    vector<FrozenDD> values(vars.size());
+    vector<bool> found(vars.size(), false);
+    unsigned long nvar = r.getVarint();
+    FrozenDD ignored;
+    for (unsigned long v=0; v < nvar and !r.failed(); v++)
+    {
+        unsigned long len = r.getVarint();
+        if (len > size) break;
+        string name;
+        for (unsigned long i=0; i < len; i++) name += (char) r.getByte();
+
+        int slot = find(name);
+        FrozenDD& f = (slot >= 0) ? values[slot] : ignored;
+        if (!r.read(f, false)) break;
+        if (slot >= 0)
+        {
+            if (f.isBDD() != (vars[slot].bdd != nullptr)) break;
+            found[slot] = true;
+        }
+    }
+
+    bool ok = !r.failed() and blocks.size() == nblock;
+    for (unsigned v=0; v < vars.size(); v++) ok = ok and found[v];
+
+    if (!ok)
+    {
+        condMgr().clear();
+        condMgr().swapConditions(old_conds);
+        return false;
+    }
+
+    // the other diagrams refer to the old conditions; they must not be reordered.
+    old_conds.clear();
+    condMgr().dropDiagrams();
+    AAF::setDefault(last);
+
+    bCond().in_if = in_if;
+    bCond().conditions.clear();
+    for (unsigned b=0; b < blocks.size(); b++)
+    {
+        BDD* cond = new BDD();
+        cond->setRoot(blocks[b].thawBDD());
+        bCond().conditions.push_back(cond);
+    }
+
+    for (unsigned v=0; v < vars.size(); v++)
+    {
+        if (vars[v].aadd != nullptr)
+        {
+            vars[v].aadd->setRoot(values[v].thawAADD());
+            vars[v].aadd->link();
+        }
+        else
+        {
+            vars[v].bdd->setRoot(values[v].thawBDD());
+            vars[v].bdd->link();
+        }
+    }
+    return true;
+}
+
+/**
+ @brief Restores the state from a checkpoint file.
+ @return 0 if no error or 1 in case of error; then the state is not changed.
+ */
+int DDCheckpoint::restore(string file_name)
+{
+    DDMappedFile file(file_name);
+    return restore(file.getData(), file.getSize()) ? 0 : 1;
+}
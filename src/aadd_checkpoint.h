@@ -0,0 +1,93 @@
+/**
+
+ @file aadd_checkpoint.h
+
+ @ingroup AADD
+
+ @brief Checkpoint and restore of the state of a symbolic simulation.
+
+ @details The state of a run consists of the path conditions in condMgr(), the highest noise
+ symbol AAF::last, the stack of block conditions in bCond(), and the values of the AADD and BDD
+ variables of the model. A checkpoint saves all of them in the binary format of aadd_serialize.h.
+ Variables are registered by a unique name; restoring a checkpoint sets the registered variables
+ with the same name.
+ @details A checkpoint can be saved to a file, e.g. to resume a long run after a crash, or to
+ a memory buffer, e.g. to fork a run at a time step and explore variants from there.
+ @details Restoring replaces the path conditions. Only the registered variables and the restored
+ block conditions are valid afterwards. All other diagrams, e.g. unregistered variables or
+ temporaries, still refer to the old conditions: they are no longer updated by reordering and
+ must not be used after a restore, except for deleting them. A restore inside a conditional
+ statement or loop, i.e. while bCond().inCond(), is rejected, as the block conditions of the
+ statement would refer to the old conditions.
+
+ @copyright@parblock
+ Copyright (c) 2017  Carna Radojicic, Christoph Grimm, Design of Cyber-Physical Systems
+ TU Kaiserslautern Postfach 3049 67663 Kaiserslautern radojicic@cs.uni-kl.de
+
+ This file is part of AADD package.
+
+ AADD is free software: you can redistribute it and/or modify it
+ under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ AADD is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public
+ License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with AADD package. If not, see <http://www.gnu.org/licenses/>.
+ @endparblock
+ */
+
+#ifndef aadd_checkpoint_h
+#define aadd_checkpoint_h
+
+#include <string>
+#include <vector>
+
+#include "aadd_serialize.h"
+
+
+/**
+ @brief Saves and restores the state of a symbolic simulation.
+ @details Usage:
+ @verbatim
+   DDCheckpoint cp;
+   cp.add("level", level);   cp.add("rate", rate);
+   ...
+   cp.save("run.ckpt");      // at time step T
+   ...
+   cp.restore("run.ckpt");   // continue from time step T
+ @endverbatim
+ */
+class DDCheckpoint
+{
+public:
+    // registers variables that are saved and restored.
+    void add(const string& name, AADD& var);
+    void add(const string& name, BDD& var);
+    void remove(const string& name);
+
+    // checkpoint to and from a file; return 0 if no error or 1 in case of error.
+    int save(string file_name) const;
+    int restore(string file_name);
+
+    // checkpoint to and from a stream resp. memory buffer.
+    void save(std::ostream& s) const;
+    bool restore(const unsigned char* data, size_t size);
+
+protected:
+    struct variable
+    {
+        string name;
+        AADD*  aadd;     // either aadd or bdd is set.
+        BDD*   bdd;
+    };
+    vector<variable> vars;
+
+    int find(const string& name) const;
+};
+
+#endif /* aadd_checkpoint_h */
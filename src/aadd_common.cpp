@@ -59,6 +59,12 @@ AADDNode::AADDNode(const AAF& val):
     this->value=val;
 }
 
+AADDNode::AADDNode(AAF&& val): 
+	DDNode(MAXINDEX, nullptr, nullptr)
+{
+    this->value=std::move(val);
+}
+
 AADDNode::AADDNode(const unsigned long index, AADDNode*T, AADDNode*F): 
 	DDNode(index, T, F)
 {
@@ -119,7 +125,7 @@ AADD::AADD(const AAF& cst)
  @brief Copy constructor
  @author Carna Radojicic, Christoph Grimm
  */
-AADD::AADD(const AADD &from)
+AADD::AADD(const AADD &from): DDBase<AAF>()
 {
     if (from.root->isLeaf())
     {
@@ -184,7 +190,9 @@ AADD::~AADD()
 AADD& AADD::assign(const AADD& right)
 {
     if (bCond().inCond())  {   // in conditional stmt.
+        profiler().beginAssign(numLeaves());
         ITE(bCond().blockCondition(), *new AADD(right), *this);
+        profiler().endAssign(numLeaves());
     } else {                    // not in any conditional statement.
         if ( this!=&right ) {
             // first free memory of (*this)
@@ -196,6 +204,25 @@ AADD& AADD::assign(const AADD& right)
     return (*this);
 }
 
+/**
+ @brief Assigns a new tree, e.g. the result of an expression, while considering block conditions.
+ @details This AADD takes ownership of result; it is not copied outside of conditional statements.
+ @return AADD this with result.
+ */
+AADD& AADD::assignRoot(AADDNode* result)
+{
+    if (bCond().inCond())  {   // in conditional stmt.
+        AADD right;
+        right.setRoot(result);
+        profiler().beginAssign(numLeaves());
+        ITE(bCond().blockCondition(), right, *this);
+        profiler().endAssign(numLeaves());
+    } else {
+        setRoot(result);
+    }
+    return (*this);
+}
+
 /**
  @brief Assigment operator of C++ AADD <- AADD
  @details Assigns an AADD right to AADD and returns reference.
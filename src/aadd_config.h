@@ -9,3 +9,6 @@
 
 // @brief Defining NDEBUG disables assertions, defining DEBUG enables assertions. 
 #define DEBUG
+
+// @brief Defining AADD_STATISTICS compiles in the counters of aadd_stats.h.
+/* #undef AADD_STATISTICS */
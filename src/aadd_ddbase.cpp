@@ -46,6 +46,9 @@
 template <>
 DDNode<bool>::~DDNode()
 {
+    live--;
+    delete bounds;
+
     // There are shared nodes, e.g. ONE and ZERO.
     // They may never be deleted. If, this is an error.
     assert( this->isNotShared() );
@@ -60,6 +63,9 @@ DDNode<bool>::~DDNode()
 template<>
 DDNode<AAF>::~DDNode()
 {
+    live--;
+    delete bounds;
+
     // There are shared nodes, e.g. ONE and ZERO.
     // They may never be deleted. If, this is an error.
     assert( this->isNotShared() );
@@ -159,7 +165,7 @@ int DDBase<AAF>::printFile(FILE* fp, const DDNode<AAF>* node) const
   {
       if (node->isLeaf() )
       {
-          AAF val=node->getValue();
+          const AAF& val=node->getValue();
           
           if (val.getlength()==0)
           {
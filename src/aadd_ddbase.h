@@ -45,6 +45,7 @@
 
 #include "aa.h"
 #include "aadd_mgr.h"
+#include "aadd_stats.h"
 
 using namespace std;
 
@@ -56,6 +57,19 @@ using namespace std;
  */
 const unsigned long MAXINDEX=numeric_limits<unsigned long>::max();
 
+/**
+ @brief Bounds of a leaf that are cached by solve_lp.
+ @details data are the path conditions and LP options the bounds were computed for; key is a
+ hash of data that rejects other paths quickly.
+ */
+struct leaf_bounds
+{
+    unsigned long long key;
+    vector<unsigned long long> data;
+    double min, max;
+};
+
+
 /**
  @brief Node of a binary decision diagram with leaf nodes of LeafType.
  */
@@ -69,8 +83,13 @@ public:
     bool isShared() const;
     bool isNotShared() const;
     
-    ValueT getValue() const;
-    void setValue(const ValueT& v)  { value = v; }; 
+    const ValueT& getValue() const;
+    void setValue(const ValueT& v)  { value = v; clearBounds(); }; 
+    
+    const leaf_bounds* getBounds() const  { return bounds; };
+    void setBounds(unsigned long long key, const vector<unsigned long long>& data,
+                   double min, double max) const;
+    void clearBounds() const              { delete bounds; bounds = nullptr; };
     
     AAF& getCond() const             { return condMgr().getCond(index); };
     vector<AAF> getConds() const;
@@ -93,8 +112,11 @@ protected:
     DDNode<ValueT> *T;    /** 1(node); NULL if leaf-node */
     DDNode<ValueT> *F;    /** 0(node); NULL if leaf-node */
     ValueT value;         /** Value if leaf-node */
+    mutable leaf_bounds* bounds; /** cached bounds of the value; NULL if none */
     
 public:
+    static unsigned long live;   /** number of allocated nodes, for reordering */
+
     DDNode(unsigned long index, DDNode<ValueT> *T, DDNode<ValueT> *F);
     DDNode(const DDNode<ValueT>& from); // copy constructor
     ~DDNode();
@@ -128,6 +150,21 @@ public:
     
     DDNode<ValT>* root;                 // return the root of BDD or AADD.
     static unsigned long last;
+
+    // All live diagrams are in a list, so that reordering can update them.
+    DDBase();
+    DDBase(const DDBase<ValT>&);
+    ~DDBase();
+    DDBase<ValT>& operator=(const DDBase<ValT>& from) { root = from.root; return *this; };
+
+    void link();                        // adds the diagram to the list, if not in it.
+    void unlink();                      // removes the diagram from the list, if in it.
+    static void unlinkAll();            // empties the list, e.g. if the conditions are replaced.
+
+    static DDBase<ValT>* registry;      // first diagram in list of live diagrams.
+    DDBase<ValT>* reg_prev;
+    DDBase<ValT>* reg_next;
+    bool          reg_linked;           // true if in the list.
 };
 
 
@@ -39,6 +39,77 @@
 #include "aadd_ddbase.h"
 
 
+template<class ValT>
+unsigned long DDNode<ValT>::live = 0;
+
+template<class ValT>
+DDBase<ValT>* DDBase<ValT>::registry = nullptr;
+
+
+/**
+ @brief Constructor; adds the diagram to the list of live diagrams.
+ */
+template<class ValT>
+DDBase<ValT>::DDBase()
+{
+    root = nullptr;
+    reg_linked = false;
+    link();
+}
+
+/**
+ @brief Copy constructor; the root is taken over as by the implicit one, the list is not.
+ */
+template<class ValT>
+DDBase<ValT>::DDBase(const DDBase<ValT>& from): DDBase()
+{
+    root = from.root;
+}
+
+/**
+ @brief Destructor; removes the diagram from the list of live diagrams.
+ */
+template<class ValT>
+DDBase<ValT>::~DDBase()
+{
+    unlink();
+}
+
+template<class ValT>
+void DDBase<ValT>::link()
+{
+    if (reg_linked) return;
+    reg_prev = nullptr;
+    reg_next = registry;
+    if (registry != nullptr) registry->reg_prev = this;
+    registry = this;
+    reg_linked = true;
+}
+
+template<class ValT>
+void DDBase<ValT>::unlink()
+{
+    if (!reg_linked) return;
+    if (reg_prev != nullptr) reg_prev->reg_next = reg_next;
+    else registry = reg_next;
+    if (reg_next != nullptr) reg_next->reg_prev = reg_prev;
+    reg_prev = reg_next = nullptr;
+    reg_linked = false;
+}
+
+/**
+ @brief Removes all diagrams from the list of live diagrams.
+ @details Used if the path conditions are replaced; the diagrams refer to conditions that
+ no longer exist, and reordering must not change them. Diagrams created afterwards are
+ in the list again.
+ */
+template<class ValT>
+void DDBase<ValT>::unlinkAll()
+{
+    while (registry != nullptr) registry->unlink();
+}
+
+
 /**
  @brief Copy constructor. 
  @author Carna Radojicic, Christoph Grimm
@@ -46,12 +117,16 @@
 template<class ValT>
 DDNode<ValT>::DDNode(const DDNode<ValT> &from)
 {
+    AADD_STAT_INC(node_allocs);
+    live++;
+    bounds = NULL;
     if (from.isLeaf())
     {
         assert(from.isNotShared()); // If assertion fails, shared node e.g. ONE would be copied
         index = MAXINDEX;
         value = from.getValue();
         T = F = NULL;
+        if (from.bounds != NULL) bounds = new leaf_bounds(*from.bounds);
     }
     else // no leaf, recursion
     {
@@ -71,9 +146,27 @@ DDNode<ValT>::DDNode(const DDNode<ValT> &from)
 template<class LeafT>
 DDNode<LeafT>::DDNode(unsigned long index, DDNode<LeafT>* T, DDNode<LeafT>* F)
 {
+    AADD_STAT_INC(node_allocs);
+    live++;
     this->index = index;
     this->T = T;
     this->F = F;
+    this->bounds = NULL;
+}
+
+
+/**
+ @brief Caches bounds of the value of a leaf; they are deleted with the node or its value.
+ */
+template<class ValT>
+void DDNode<ValT>::setBounds(unsigned long long key, const vector<unsigned long long>& data,
+                             double min, double max) const
+{
+    if (bounds == NULL) bounds = new leaf_bounds;
+    bounds->key = key;
+    bounds->data = data;
+    bounds->min = min;
+    bounds->max = max;
 }
 
 
@@ -115,7 +208,7 @@ bool DDNode<LeafT>::isInternal() const
 };
 
 template<class LeafT>
-LeafT DDNode<LeafT>::getValue() const
+const LeafT& DDNode<LeafT>::getValue() const
 {
     return value;
 };
@@ -0,0 +1,361 @@
+/**
+
+ @file aadd_eval.cpp
+
+ @ingroup AADD
+
+ @brief Concrete evaluation of AADD and BDD at given values of the noise symbols.
+
+ @details Fixing each noise symbol e_i to a value in [-1,1] selects exactly one path of a
+ decision diagram. The methods here return the leaf value on this path. They are meant to
+ validate symbolic results by sampling (e.g. Monte-Carlo checks).
+ @details Samples are given as a matrix of M rows (samples) and K columns (noise symbols),
+ stored row by row. Column k holds the value of the noise symbol e(k+1). Noise symbols with
+ an index larger than K are assumed to be 0, i.e. the central value is taken.
+ @details The batch evaluation walks the diagram once for all samples: at each internal node
+ the samples are partitioned by the sign of the condition, and conditions and leaf affine forms
+ are evaluated for all samples of a partition in a loop over contiguous columns that the
+ compiler can vectorize.
+
+ @copyright@parblock
+ Copyright (c) 2017  Carna Radojicic, Christoph Grimm, Design of Cyber-Physical Systems
+ TU Kaiserslautern Postfach 3049 67663 Kaiserslautern radojicic@cs.uni-kl.de
+
+ This file is part of AADD package.
+
+ AADD is free software: you can redistribute it and/or modify it
+ under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ AADD is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public
+ License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with AADD package. If not, see <http://www.gnu.org/licenses/>.
+ @endparblock
+ */
+
+#include <vector>
+
+#include "aadd.h"
+#include "aadd_frozen.h"
+
+
+/**
+ @brief Evaluates an affine form c + sum dv[i]*e(id[i]) at one assignment eps[0..K-1] of the noise symbols.
+ */
+static double evalAffine(double c, const unsigned* id, const double* dv, unsigned len,
+                         const double* eps, unsigned K)
+{
+    double res = c;
+    for (unsigned i=0; i < len; i++)
+    {
+        if (id[i] >= 1 && id[i] <= K) res += dv[i]*eps[id[i]-1];
+    }
+    return res;
+}
+
+/**
+ @brief Evaluates the affine part of an AAF at one assignment eps[0..K-1] of the noise symbols.
+ @details The offsets offset_min, offset_max are not considered; they bound round-off
+ and approximation errors, not a dependency on noise symbols.
+ */
+static double evalAffine(const AAF& f, const double* eps, unsigned K)
+{
+    return evalAffine(f.getcenter(), f.getIndexes(), f.getDeviations(), f.getlength(), eps, K);
+}
+
+
+/**
+ @brief Evaluates an affine form for the n samples sel[0..n-1].
+ @details cols holds the samples column by column, i.e. cols[(k-1)*M+s] is the value
+ of noise symbol e_k in sample s. The result for sel[j] is written to res[j].
+ If n == M, sel must select all samples in their order.
+ */
+static void evalAffineBatch(double c, const unsigned* id, const double* dv, unsigned len,
+                            const double* cols, unsigned M, unsigned K,
+                            const unsigned* sel, unsigned n,
+                            double* res)
+{
+    for (unsigned j=0; j < n; j++) res[j] = c;
+
+    for (unsigned i=0; i < len; i++)
+    {
+        if (id[i] < 1 || id[i] > K) continue;
+
+        const double  d   = dv[i];
+        const double* col = cols + (size_t)(id[i]-1)*M;
+
+        if (n == M) // all samples; contiguous access.
+            for (unsigned j=0; j < n; j++) res[j] += d*col[j];
+        else
+            for (unsigned j=0; j < n; j++) res[j] += d*col[sel[j]];
+    }
+}
+
+static void evalAffineBatch(const AAF& f,
+                            const double* cols, unsigned M, unsigned K,
+                            const unsigned* sel, unsigned n,
+                            double* res)
+{
+    evalAffineBatch(f.getcenter(), f.getIndexes(), f.getDeviations(), f.getlength(),
+                    cols, M, K, sel, n, res);
+}
+
+
+/**
+ @brief Writes the leaf values of an AADD leaf for the selected samples.
+ */
+static void evalLeafBatch(const DDNode<AAF>* f,
+                          const double* cols, unsigned M, unsigned K,
+                          const unsigned* sel, unsigned n,
+                          vector<double>& tmp, double* out)
+{
+    evalAffineBatch(f->getValue(), cols, M, K, sel, n, tmp.data());
+    for (unsigned j=0; j < n; j++) out[sel[j]] = tmp[j];
+}
+
+static void evalLeafBatch(const DDNode<bool>* f,
+                          const double*, unsigned, unsigned,
+                          const unsigned* sel, unsigned n,
+                          vector<double>&, bool* out)
+{
+    const bool v = f->getValue();
+    for (unsigned j=0; j < n; j++) out[sel[j]] = v;
+}
+
+
+/**
+ @brief Stable partition of sel[0..n-1]: samples with cond[j] > 0 first.
+ @details The samples with cond <= 0 are kept in a scratch buffer of the thread that only
+ grows, so that the recursion does not allocate memory at each node.
+ @return number of samples with cond > 0.
+ */
+static unsigned partition(unsigned* sel, unsigned n, const vector<double>& cond)
+{
+    static thread_local vector<unsigned> fsel;
+    if (fsel.size() < n) fsel.resize(n);
+
+    unsigned nt = 0, nf = 0;
+    for (unsigned j=0; j < n; j++)
+    {
+        if (cond[j] > 0) sel[nt++] = sel[j];
+        else fsel[nf++] = sel[j];
+    }
+    for (unsigned j=0; j < nf; j++) sel[nt+j] = fsel[j];
+    return nt;
+}
+
+
+/**
+ @brief Recursive batch evaluation of a decision diagram for the samples in sel.
+ @details At an internal node, the condition is evaluated for all selected samples, and
+ the samples are partitioned into those that take the true and the false branch.
+ The partitions are stored in sel itself; the recursion needs no further memory per node.
+ */
+template<class ValT, class ResT>
+static void evalBatch(const DDNode<ValT>* f,
+                      const double* cols, unsigned M, unsigned K,
+                      unsigned* sel, unsigned n,
+                      vector<double>& tmp, ResT* out)
+{
+    if (n == 0) return;
+
+    if (f->isLeaf())
+    {
+        evalLeafBatch(f, cols, M, K, sel, n, tmp, out);
+        return;
+    }
+
+    evalAffineBatch(f->getCond(), cols, M, K, sel, n, tmp.data());
+
+    unsigned nt = partition(sel, n, tmp);
+
+    evalBatch(f->getT(), cols, M, K, sel, nt, tmp, out);
+    evalBatch(f->getF(), cols, M, K, sel+nt, n-nt, tmp, out);
+}
+
+
+/**
+ @brief Transposes the M x K sample matrix (row by row) into columns.
+ */
+static vector<double> transpose(const double* samples, unsigned M, unsigned K)
+{
+    vector<double> cols((size_t)M*K);
+    for (unsigned s=0; s < M; s++)
+        for (unsigned k=0; k < K; k++)
+            cols[(size_t)k*M+s] = samples[(size_t)s*K+k];
+    return cols;
+}
+
+
+/**
+ @brief Evaluates the AADD at one assignment of the noise symbols.
+ @details eps[k] is the value of the noise symbol e(k+1) and must be in [-1,1].
+ Noise symbols with index larger than K are assumed to be 0.
+ The path is selected by the sign of the conditions: true branch if cond > 0.
+ @return value of the affine form in the selected leaf at eps.
+ */
+double AADD::Evaluate(const double* eps, unsigned K) const
+{
+    const DDNode<AAF>* f = getRoot();
+    while (f->isInternal())
+    {
+        if (evalAffine(f->getCond(), eps, K) > 0) f = f->getT();
+        else f = f->getF();
+    }
+    return evalAffine(f->getValue(), eps, K);
+}
+
+
+/**
+ @brief Evaluates the AADD at M assignments of the noise symbols in one pass.
+ @details samples is a M x K matrix, stored row by row; row s is one sample as in Evaluate(eps, K).
+ @return vector with the M values of the AADD.
+ */
+vector<double> AADD::Evaluate(const double* samples, unsigned M, unsigned K) const
+{
+    vector<double> res(M);
+    vector<double> cols = transpose(samples, M, K);
+    vector<double> tmp(M);
+    vector<unsigned> sel(M);
+    for (unsigned s=0; s < M; s++) sel[s] = s;
+
+    evalBatch(root, cols.data(), M, K, sel.data(), M, tmp, res.data());
+    return res;
+}
+
+
+/**
+ @brief Evaluates the BDD at one assignment of the noise symbols.
+ @see AADD::Evaluate
+ @return truth value of the selected leaf.
+ */
+bool BDD::Evaluate(const double* eps, unsigned K) const
+{
+    const DDNode<bool>* f = getRoot();
+    while (f->isInternal())
+    {
+        if (evalAffine(f->getCond(), eps, K) > 0) f = f->getT();
+        else f = f->getF();
+    }
+    return f->getValue();
+}
+
+
+/**
+ @brief Evaluates the BDD at M assignments of the noise symbols in one pass.
+ @see AADD::Evaluate
+ @return vector with the M truth values of the BDD.
+ */
+vector<bool> BDD::Evaluate(const double* samples, unsigned M, unsigned K) const
+{
+    // vector<bool> is packed; evaluate into bytes and convert.
+    bool* out = new bool[M];
+    vector<double> cols = transpose(samples, M, K);
+    vector<double> tmp(M);
+    vector<unsigned> sel(M);
+    for (unsigned s=0; s < M; s++) sel[s] = s;
+
+    evalBatch(root, cols.data(), M, K, sel.data(), M, tmp, out);
+
+    vector<bool> res(out, out+M);
+    delete [] out;
+    return res;
+}
+
+
+/**
+ @brief Batch evaluation of a frozen AADD for the samples in sel; as evalBatch.
+ */
+static void evalFrozenBatch(const FrozenDD& f, unsigned rec,
+                            const double* cols, unsigned M, unsigned K,
+                            unsigned* sel, unsigned n,
+                            vector<double>& tmp, double* out)
+{
+    if (n == 0) return;
+
+    const frozenNode& node = f.getNodes()[rec];
+    const unsigned* id = f.getPoolIndexes().data();
+    const double*   dv = f.getPoolDeviations().data();
+
+    if (node.isLeaf())
+    {
+        const frozenForm& l = f.getLeaves()[node.form];
+        evalAffineBatch(l.center, id+l.first, dv+l.first, l.length, cols, M, K, sel, n, tmp.data());
+        for (unsigned j=0; j < n; j++) out[sel[j]] = tmp[j];
+        return;
+    }
+
+    const frozenForm& c = f.getConds()[node.form];
+    evalAffineBatch(c.center, id+c.first, dv+c.first, c.length, cols, M, K, sel, n, tmp.data());
+
+    unsigned nt = partition(sel, n, tmp);
+    evalFrozenBatch(f, node.T, cols, M, K, sel, nt, tmp, out);
+    evalFrozenBatch(f, node.F, cols, M, K, sel+nt, n-nt, tmp, out);
+}
+
+
+/**
+ @brief Follows the path selected by eps in a frozen diagram.
+ @return record of the leaf.
+ */
+static unsigned frozenPath(const FrozenDD& f, const double* eps, unsigned K)
+{
+    const vector<frozenNode>& nodes = f.getNodes();
+    const unsigned* id = f.getPoolIndexes().data();
+    const double*   dv = f.getPoolDeviations().data();
+
+    unsigned rec = 0;
+    while (!nodes[rec].isLeaf())
+    {
+        const frozenForm& c = f.getConds()[nodes[rec].form];
+        if (evalAffine(c.center, id+c.first, dv+c.first, c.length, eps, K) > 0) rec = nodes[rec].T;
+        else rec = nodes[rec].F;
+    }
+    return rec;
+}
+
+
+/**
+ @brief Evaluates a frozen AADD at one assignment of the noise symbols.
+ @see AADD::Evaluate
+ */
+double FrozenDD::Evaluate(const double* eps, unsigned K) const
+{
+    assert(!bdd);
+    const frozenForm& l = leaves[nodes[frozenPath(*this, eps, K)].form];
+    return evalAffine(l.center, pool_index.data()+l.first, pool_dev.data()+l.first, l.length, eps, K);
+}
+
+
+/**
+ @brief Evaluates a frozen AADD at M assignments of the noise symbols in one pass.
+ @see AADD::Evaluate
+ */
+vector<double> FrozenDD::Evaluate(const double* samples, unsigned M, unsigned K) const
+{
+    assert(!bdd);
+    vector<double> res(M);
+    vector<double> cols = transpose(samples, M, K);
+    vector<double> tmp(M);
+    vector<unsigned> sel(M);
+    for (unsigned s=0; s < M; s++) sel[s] = s;
+
+    evalFrozenBatch(*this, 0, cols.data(), M, K, sel.data(), M, tmp, res.data());
+    return res;
+}
+
+
+/**
+ @brief Evaluates a frozen BDD at one assignment of the noise symbols.
+ @see BDD::Evaluate
+ */
+bool FrozenDD::EvaluateBDD(const double* eps, unsigned K) const
+{
+    assert(bdd);
+    return nodes[frozenPath(*this, eps, K)].form != 0;
+}
@@ -0,0 +1,445 @@
+/**
+
+ @file aadd_expr.h
+
+ @ingroup AADD
+
+ @brief Expression templates for fused arithmetic on AADD.
+
+ @details The arithmetic operators of AADD create a complete intermediate AADD for each
+ operator. With lazy(), an arithmetic expression is instead recorded as a type and evaluated
+ when it is assigned to an AADD:
+ @verbatim
+   wlevel = lazy(wlevel) + (1.+lazy(uncertainty1))*T;
+ @endverbatim
+ The assignment traverses the diagrams of all AADD operands of the expression simultaneously,
+ taking the smallest condition index of the current nodes as ApplyBinOp does, and computes the
+ value of each leaf of the result from the leaves of the operands in one step: sums, differences
+ and products with scalars are one affine combination, computed by lincomb. Only products and
+ quotients of affine forms are computed by the AAF operators. No intermediate diagrams are
+ created. As by lincomb, the offsets of a subtracted operand are subtracted as an interval.
+ Assignment within ifS/elseS considers the block condition as the assignment of an AADD.
+ @details Operands of an expression are AADD, AAF and double; at least one of them must be
+ wrapped by lazy(). AADD variables are referenced, not copied, until the assignment; temporary
+ AADD are taken over by the expression, so that it can be kept, e.g. in an auto variable.
+
+ @copyright@parblock
+ Copyright (c) 2017  Carna Radojicic, Christoph Grimm, Design of Cyber-Physical Systems
+ TU Kaiserslautern Postfach 3049 67663 Kaiserslautern radojicic@cs.uni-kl.de
+
+ This file is part of AADD package.
+
+ AADD is free software: you can redistribute it and/or modify it
+ under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ AADD is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public
+ License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with AADD package. If not, see <http://www.gnu.org/licenses/>.
+ @endparblock
+ */
+
+#ifndef aadd_expr_h
+#define aadd_expr_h
+
+#include <memory>
+
+#include "aadd.h"
+
+template<class E> AADDNode* applyExpr(const E& e, const AADDNode* const* f);
+
+
+/**
+ @brief Affine combination sum w[i]*x[i] + c of the leaves of an expression.
+ @details N bounds the number of terms, K the number of nonlinear subexpressions. Their
+ values are computed into tmp, so that they can be terms as well. Constants without noise
+ symbols and offsets are added to c.
+ */
+template<unsigned N, unsigned K>
+class exprTerms
+{
+public:
+    exprTerms(): n(0), k(0), c(0.0) {};
+
+    void add(double weight, const AAF& value)
+    {
+        if (value.getlength() == 0 and value.offset_min == 0.0 and value.offset_max == 0.0)
+            c += weight*value.getcenter();
+        else
+        {
+            w[n] = weight;
+            x[n++] = &value;
+        }
+    };
+    AAF& temporary()                             { return tmp[k++]; };
+    AAF sum() const                              { return lincomb(n, w, x, c); };
+
+private:
+    unsigned n, k;
+    double w[N];
+    const AAF* x[N];
+    double c;
+    AAF tmp[K+1];
+};
+
+
+/**
+ @brief Base of all expressions; E is the type of the expression.
+ @details An expression with arity N refers to N AADD operands. Its value at a leaf of the
+ result is computed by eval from the leaves f[0..N-1] reached in the operands. collect adds
+ the expression, multiplied by w, to an affine combination of the leaves; a sum of the
+ operands is thereby computed by one call of lincomb.
+ */
+template<class E>
+class aaddExpr
+{
+public:
+    const E& expr() const { return static_cast<const E&>(*this); };
+
+    // builds the diagram of the expression; returns the root of a new tree.
+    AADDNode* build() const
+    {
+        static_assert(E::arity > 0, "expression must have an AADD operand");
+        const AADDNode* f[E::arity];
+        expr().roots(f);
+        return applyExpr(expr(), f);
+    };
+};
+
+
+/**
+ @brief Expression that refers to an AADD.
+ */
+class aaddRefExpr: public aaddExpr<aaddRefExpr>
+{
+public:
+    static const unsigned arity = 1, terms = 1, temps = 0;
+
+    aaddRefExpr(const AADD& a): ref(a) {};
+
+    void roots(const AADDNode** f) const         { f[0] = ref.getRoot(); };
+    const AAF& eval(const AADDNode* const* f) const { return f[0]->getValue(); };
+
+    template<unsigned N, unsigned K>
+    void collect(const AADDNode* const* f, double w, exprTerms<N, K>& t) const
+    { t.add(w, f[0]->getValue()); };
+
+protected:
+    const AADD& ref;
+};
+
+
+/**
+ @brief Expression that holds a temporary AADD.
+ @details The diagram is taken over from the temporary, without a copy, and shared by the
+ copies of the expression, so that an expression can outlive the statement that created it.
+ */
+class aaddValExpr: public aaddExpr<aaddValExpr>
+{
+public:
+    static const unsigned arity = 1, terms = 1, temps = 0;
+
+    aaddValExpr(AADD&& a): value(new AADD()) { value->setRoot(a.stealRoot()); };
+
+    void roots(const AADDNode** f) const         { f[0] = value->getRoot(); };
+    const AAF& eval(const AADDNode* const* f) const { return f[0]->getValue(); };
+
+    template<unsigned N, unsigned K>
+    void collect(const AADDNode* const* f, double w, exprTerms<N, K>& t) const
+    { t.add(w, f[0]->getValue()); };
+
+protected:
+    std::shared_ptr<AADD> value;
+};
+
+
+/**
+ @brief Expression that is a constant affine form.
+ */
+class aaddConstExpr: public aaddExpr<aaddConstExpr>
+{
+public:
+    static const unsigned arity = 0, terms = 1, temps = 0;
+
+    aaddConstExpr(const AAF& v): value(v) {};
+
+    void roots(const AADDNode**) const           { };
+    const AAF& eval(const AADDNode* const*) const { return value; };
+
+    template<unsigned N, unsigned K>
+    void collect(const AADDNode* const*, double w, exprTerms<N, K>& t) const
+    { t.add(w, value); };
+
+    // true if the constant is a scalar s, without noise symbols and offsets.
+    bool scalar(double& s) const
+    {
+        s = value.getcenter();
+        return value.getlength() == 0 and value.offset_min == 0.0 and value.offset_max == 0.0;
+    };
+
+protected:
+    AAF value;
+};
+
+template<class E>
+inline bool exprScalar(const E&, double&)              { return false; }
+inline bool exprScalar(const aaddConstExpr& e, double& s) { return e.scalar(s); }
+
+
+/**
+ @brief Expression that applies the binary operation Op to L and R.
+ @details The operands of L come before the operands of R.
+ */
+template<class L, class R, class Op>
+class aaddBinExpr: public aaddExpr<aaddBinExpr<L, R, Op> >
+{
+public:
+    static const unsigned arity = L::arity + R::arity;
+    static const unsigned terms = L::terms + R::terms;
+    static const unsigned temps = L::temps + R::temps + Op::temps;
+
+    aaddBinExpr(const L& l, const R& r): left(l), right(r) {};
+
+    void roots(const AADDNode** f) const
+    {
+        left.roots(f);
+        right.roots(f+L::arity);
+    };
+
+    AAF eval(const AADDNode* const* f) const
+    {
+        exprTerms<terms, temps> t;
+        collect(f, 1.0, t);
+        return t.sum();
+    };
+
+    template<unsigned N, unsigned K>
+    void collect(const AADDNode* const* f, double w, exprTerms<N, K>& t) const
+    {
+        Op::collect(left, f, right, f+L::arity, w, t);
+    };
+
+protected:
+    L left;
+    R right;
+};
+
+
+/**
+ @brief Expression that negates E.
+ */
+template<class E>
+class aaddNegExpr: public aaddExpr<aaddNegExpr<E> >
+{
+public:
+    static const unsigned arity = E::arity, terms = E::terms, temps = E::temps;
+
+    aaddNegExpr(const E& e): arg(e) {};
+
+    void roots(const AADDNode** f) const         { arg.roots(f); };
+
+    AAF eval(const AADDNode* const* f) const
+    {
+        exprTerms<terms, temps> t;
+        collect(f, 1.0, t);
+        return t.sum();
+    };
+
+    template<unsigned N, unsigned K>
+    void collect(const AADDNode* const* f, double w, exprTerms<N, K>& t) const
+    { arg.collect(f, -w, t); };
+
+protected:
+    E arg;
+};
+
+
+// Operations on the leaf values of binary expressions. Sums and products with a scalar are
+// added to the affine combination; other products and quotients are computed by AAF, as terms.
+struct exprPlus
+{
+    static const unsigned temps = 0;
+    template<class L, class R, unsigned N, unsigned K>
+    static void collect(const L& l, const AADDNode* const* fl, const R& r, const AADDNode* const* fr,
+                        double w, exprTerms<N, K>& t)
+    {
+        l.collect(fl, w, t);
+        r.collect(fr, w, t);
+    };
+};
+
+struct exprMinus
+{
+    static const unsigned temps = 0;
+    template<class L, class R, unsigned N, unsigned K>
+    static void collect(const L& l, const AADDNode* const* fl, const R& r, const AADDNode* const* fr,
+                        double w, exprTerms<N, K>& t)
+    {
+        l.collect(fl, w, t);
+        r.collect(fr, -w, t);
+    };
+};
+
+struct exprTimes
+{
+    static const unsigned temps = 1;
+    template<class L, class R, unsigned N, unsigned K>
+    static void collect(const L& l, const AADDNode* const* fl, const R& r, const AADDNode* const* fr,
+                        double w, exprTerms<N, K>& t)
+    {
+        double s;
+        if (exprScalar(r, s)) l.collect(fl, w*s, t);
+        else if (exprScalar(l, s)) r.collect(fr, w*s, t);
+        else
+        {
+            AAF& v = t.temporary();
+            v = l.eval(fl)*r.eval(fr);
+            t.add(w, v);
+        }
+    };
+};
+
+struct exprDivide
+{
+    static const unsigned temps = 1;
+    template<class L, class R, unsigned N, unsigned K>
+    static void collect(const L& l, const AADDNode* const* fl, const R& r, const AADDNode* const* fr,
+                        double w, exprTerms<N, K>& t)
+    {
+        AAF& v = t.temporary();
+        v = l.eval(fl)/r.eval(fr);
+        t.add(w, v);
+    };
+};
+
+
+/**
+ @brief Multi-operand apply: computes the diagram of the expression e.
+ @details f[0..N-1] are the current nodes of the N operands. The smallest condition index of
+ them is the index of the new node; operands with that index descend to their children, the
+ others are kept. If all are leaves, the leaf of the result is computed by e.eval.
+ @return the root of a new tree.
+ @see AADD::ApplyBinOp
+ */
+template<class E>
+AADDNode* applyExpr(const E& e, const AADDNode* const* f)
+{
+    const unsigned N = E::arity;
+    unsigned long index = MAXINDEX;
+
+    AADD_STAT_INC(apply_calls);
+    for (unsigned i=0; i < N; i++)
+        if (f[i]->getIndex() < index) index = f[i]->getIndex();
+
+    /* Terminal case: all operands are leaves. */
+    if (index == MAXINDEX)
+        return new AADDNode(e.eval(f));
+
+    /* Recursive step. */
+    const AADDNode *fv[N], *fvn[N];
+    for (unsigned i=0; i < N; i++)
+    {
+        if (f[i]->getIndex() == index) {
+            fv[i]  = f[i]->getT();
+            fvn[i] = f[i]->getF();
+        } else {
+            fv[i] = fvn[i] = f[i];
+        }
+    }
+
+    AADDNode* T = applyExpr(e, fv);
+    AADDNode* F = applyExpr(e, fvn);
+
+    // Maybe we can reduce?
+    if (T->isLeaf() and F->isLeaf() and T->getValue() == F->getValue())
+    {
+        delete F;
+        return T;
+    }
+    return new AADDNode(index, T, F);
+}
+
+
+/**
+ @brief Starts an expression that is evaluated on assignment to an AADD.
+ */
+inline aaddRefExpr lazy(const AADD& a)
+{
+    return aaddRefExpr(a);
+}
+
+inline aaddValExpr lazy(AADD&& a)
+{
+    return aaddValExpr(std::move(a));
+}
+
+
+/**
+ @brief Assigns the result of an expression, considering block conditions as assign.
+ */
+template<class E>
+AADD& AADD::operator=(const aaddExpr<E>& e)
+{
+    return assignRoot(e.build());
+}
+
+/**
+ @brief Constructor creating AADD with the result of an expression.
+ */
+template<class E>
+AADD::AADD(const aaddExpr<E>& e)
+{
+    root = e.build();
+}
+
+
+// Operators that create expressions. Operands that are AADD, AAF or double are wrapped.
+
+#define AADD_EXPR_OPERATOR(OP, OPT)                                                           \
+template<class L, class R>                                                                    \
+aaddBinExpr<L, R, OPT> operator OP (const aaddExpr<L>& l, const aaddExpr<R>& r)               \
+{ return aaddBinExpr<L, R, OPT>(l.expr(), r.expr()); }                                        \
+template<class L>                                                                             \
+aaddBinExpr<L, aaddRefExpr, OPT> operator OP (const aaddExpr<L>& l, const AADD& r)            \
+{ return aaddBinExpr<L, aaddRefExpr, OPT>(l.expr(), aaddRefExpr(r)); }                        \
+template<class R>                                                                             \
+aaddBinExpr<aaddRefExpr, R, OPT> operator OP (const AADD& l, const aaddExpr<R>& r)            \
+{ return aaddBinExpr<aaddRefExpr, R, OPT>(aaddRefExpr(l), r.expr()); }                        \
+template<class L>                                                                             \
+aaddBinExpr<L, aaddValExpr, OPT> operator OP (const aaddExpr<L>& l, AADD&& r)                 \
+{ return aaddBinExpr<L, aaddValExpr, OPT>(l.expr(), aaddValExpr(std::move(r))); }             \
+template<class R>                                                                             \
+aaddBinExpr<aaddValExpr, R, OPT> operator OP (AADD&& l, const aaddExpr<R>& r)                 \
+{ return aaddBinExpr<aaddValExpr, R, OPT>(aaddValExpr(std::move(l)), r.expr()); }             \
+template<class L>                                                                             \
+aaddBinExpr<L, aaddConstExpr, OPT> operator OP (const aaddExpr<L>& l, const AAF& r)           \
+{ return aaddBinExpr<L, aaddConstExpr, OPT>(l.expr(), aaddConstExpr(r)); }                    \
+template<class R>                                                                             \
+aaddBinExpr<aaddConstExpr, R, OPT> operator OP (const AAF& l, const aaddExpr<R>& r)           \
+{ return aaddBinExpr<aaddConstExpr, R, OPT>(aaddConstExpr(l), r.expr()); }                    \
+template<class L>                                                                             \
+aaddBinExpr<L, aaddConstExpr, OPT> operator OP (const aaddExpr<L>& l, double r)               \
+{ return aaddBinExpr<L, aaddConstExpr, OPT>(l.expr(), aaddConstExpr(AAF(r))); }               \
+template<class R>                                                                             \
+aaddBinExpr<aaddConstExpr, R, OPT> operator OP (double l, const aaddExpr<R>& r)               \
+{ return aaddBinExpr<aaddConstExpr, R, OPT>(aaddConstExpr(AAF(l)), r.expr()); }
+
+AADD_EXPR_OPERATOR(+, exprPlus)
+AADD_EXPR_OPERATOR(-, exprMinus)
+AADD_EXPR_OPERATOR(*, exprTimes)
+AADD_EXPR_OPERATOR(/, exprDivide)
+
+#undef AADD_EXPR_OPERATOR
+
+template<class E>
+aaddNegExpr<E> operator - (const aaddExpr<E>& e)
+{
+    return aaddNegExpr<E>(e.expr());
+}
+
+#endif /* aadd_expr_h */
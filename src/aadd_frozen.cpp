@@ -0,0 +1,289 @@
+/**
+
+ @file aadd_frozen.cpp
+
+ @ingroup AADD
+
+ @brief Freezing of AADD and BDD into a flat representation; implementation.
+
+ @details Nodes are stored in depth-first order, so that the true child of an internal
+ node is the next record. Each condition is stored once in the condition table, even if
+ several nodes refer to it.
+
+ @copyright@parblock
+ Copyright (c) 2017  Carna Radojicic, Christoph Grimm, Design of Cyber-Physical Systems
+ TU Kaiserslautern Postfach 3049 67663 Kaiserslautern radojicic@cs.uni-kl.de
+
+ This file is part of AADD package.
+
+ AADD is free software: you can redistribute it and/or modify it
+ under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ AADD is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public
+ License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with AADD package. If not, see <http://www.gnu.org/licenses/>.
+ @endparblock
+ */
+
+#include "aadd_frozen.h"
+
+
+FrozenDD::FrozenDD()
+{
+    bdd = false;
+}
+
+FrozenDD::FrozenDD(const AADD& f)
+{
+    freeze(f);
+}
+
+FrozenDD::FrozenDD(const BDD& f)
+{
+    freeze(f);
+}
+
+
+/**
+ @brief Removes all records, but keeps the allocated memory for the next freeze.
+ */
+void FrozenDD::clear()
+{
+    // reset only the entries of the scratch table that were used.
+    for (unsigned s=0; s < cond_index.size(); s++)
+        if (cond_index[s] < slot_of.size()) slot_of[cond_index[s]] = ~0u;
+
+    nodes.clear();
+    conds.clear();
+    leaves.clear();
+    pool_index.clear();
+    pool_dev.clear();
+    cond_index.clear();
+}
+
+
+/**
+ @brief Freezes an AADD.
+ */
+void FrozenDD::freeze(const AADD& f)
+{
+    clear();
+    bdd = false;
+    freezeNode(f.getRoot());
+}
+
+/**
+ @brief Freezes a BDD.
+ */
+void FrozenDD::freeze(const BDD& f)
+{
+    clear();
+    bdd = true;
+    freezeNode(f.getRoot());
+}
+
+
+/**
+ @brief Appends the affine form f to the coefficient pool and a table of forms.
+ @return entry of the form in the table.
+ */
+unsigned FrozenDD::addForm(vector<frozenForm>& table, const AAF& f)
+{
+    frozenForm form;
+    form.center     = f.getcenter();
+    form.offset_min = f.offset_min;
+    form.offset_max = f.offset_max;
+    form.first      = pool_index.size();
+    form.length     = f.getlength();
+
+    pool_index.insert(pool_index.end(), f.getIndexes(), f.getIndexes()+f.getlength());
+    pool_dev.insert(pool_dev.end(), f.getDeviations(), f.getDeviations()+f.getlength());
+
+    table.push_back(form);
+    return table.size()-1;
+}
+
+
+/**
+ @brief Returns the entry of the condition with the given index in the condition table.
+ @details Adds the condition to the table if it is not yet there.
+ */
+unsigned FrozenDD::condSlot(unsigned long index)
+{
+    if (index >= slot_of.size()) slot_of.resize(index+1, ~0u);
+
+    if (slot_of[index] == ~0u)
+    {
+        slot_of[index] = addForm(conds, condMgr().getCond(index));
+        cond_index.push_back(index);
+    }
+    return slot_of[index];
+}
+
+
+unsigned FrozenDD::addLeaf(const DDNode<AAF>* f)
+{
+    return addForm(leaves, f->getValue());
+}
+
+unsigned FrozenDD::addLeaf(const DDNode<bool>* f)
+{
+    return f->getValue() ? 1 : 0;
+}
+
+
+/**
+ @brief Appends the records of the subtree f in depth-first order.
+ @return record of f.
+ */
+template<class ValT>
+unsigned FrozenDD::freezeNode(const DDNode<ValT>* f)
+{
+    unsigned rec = nodes.size();
+    nodes.push_back(frozenNode());
+
+    if (f->isLeaf())
+    {
+        nodes[rec].index = MAXINDEX;
+        nodes[rec].form  = addLeaf(f);
+        nodes[rec].T = nodes[rec].F = 0;
+        return rec;
+    }
+
+    nodes[rec].index = f->getIndex();
+    nodes[rec].form  = condSlot(f->getIndex());
+    unsigned T = freezeNode(f->getT());
+    unsigned F = freezeNode(f->getF());
+    nodes[rec].T = T;      // nodes may have been reallocated.
+    nodes[rec].F = F;
+    return rec;
+}
+
+
+/**
+ @brief Creates an AAF from a form of the pool.
+ */
+AAF FrozenDD::getAAF(const frozenForm& form) const
+{
+    AAF res(form.center);
+    if (form.length > 0)
+        res = AAF(form.center, &pool_dev[form.first], &pool_index[form.first], form.length);
+    res.offset_min = form.offset_min;
+    res.offset_max = form.offset_max;
+    return res;
+}
+
+
+unsigned FrozenDD::numNodes() const
+{
+    return nodes.size()-numLeaves();
+}
+
+unsigned FrozenDD::numLeaves() const
+{
+    unsigned n=0;
+    for (unsigned r=0; r < nodes.size(); r++)
+        if (nodes[r].isLeaf()) n++;
+    return n;
+}
+
+
+template<>
+AADDNode* FrozenDD::thaw<AADDNode>(unsigned rec) const
+{
+    const frozenNode& n = nodes[rec];
+    if (n.isLeaf()) return new AADDNode(getAAF(leaves[n.form]));
+    return new AADDNode(n.index, thaw<AADDNode>(n.T), thaw<AADDNode>(n.F));
+}
+
+template<>
+BDDNode* FrozenDD::thaw<BDDNode>(unsigned rec) const
+{
+    const frozenNode& n = nodes[rec];
+    if (n.isLeaf()) return n.form ? ONE() : ZERO();
+    return new BDDNode(n.index, thaw<BDDNode>(n.T), thaw<BDDNode>(n.F));
+}
+
+
+/**
+ @brief Rebuilds the AADD.
+ @details The conditions are referred to by the index field of the records;
+ they must be in condMgr().
+ @return root of a new tree.
+ */
+AADDNode* FrozenDD::thawAADD() const
+{
+    assert(!bdd && !nodes.empty());
+    return thaw<AADDNode>(0);
+}
+
+/**
+ @brief Rebuilds the BDD.
+ @see thawAADD
+ */
+BDDNode* FrozenDD::thawBDD() const
+{
+    assert(bdd && !nodes.empty());
+    return thaw<BDDNode>(0);
+}
+
+
+/**
+ @brief Computes the bounds of the leaves under the path conditions, as AADD::FindBounds.
+ */
+void FrozenDD::findBounds(unsigned rec, vector<constraint<AAF> >& cons, vector<opt_sol>& res) const
+{
+    const frozenNode& n = nodes[rec];
+
+    if (n.isLeaf())
+    {
+        res.push_back(solve_lp(getAAF(leaves[n.form]), cons));
+        return;
+    }
+
+    constraint<AAF> c;
+    c.con  = getAAF(conds[n.form]);
+    c.sign = '+';
+    cons.push_back(c);
+    findBounds(n.T, cons, res);
+
+    cons.back().sign = '-';
+    findBounds(n.F, cons, res);
+    cons.pop_back();
+}
+
+
+/**
+ @brief Bounds of all leaves, in the same order as AADD::GetAllBounds.
+ */
+vector<opt_sol> FrozenDD::GetAllBounds() const
+{
+    assert(!bdd);
+    vector<constraint<AAF> > cons;
+    vector<opt_sol> res;
+    findBounds(0, cons, res);
+    return res;
+}
+
+
+/**
+ @brief Total lower and upper bound, as AADD::GetBothBounds.
+ */
+opt_sol FrozenDD::GetBothBounds() const
+{
+    vector<opt_sol> bounds = GetAllBounds();
+    opt_sol res = bounds.front();
+
+    for (unsigned i=1; i < bounds.size(); i++)
+    {
+        if (bounds[i].min < res.min) res.min = bounds[i].min;
+        if (bounds[i].max > res.max) res.max = bounds[i].max;
+    }
+    return res;
+}
@@ -0,0 +1,147 @@
+/**
+
+ @file aadd_frozen.h
+
+ @ingroup AADD
+
+ @brief Flat, contiguous representation of an AADD or BDD.
+
+ @details Freezing lowers a decision diagram into an array of node records with child offsets,
+ a table of the referenced conditions, and a packed pool of the coefficients of all conditions
+ and leaf affine forms. The frozen diagram does not depend on the condition manager and can be
+ used for fast concrete evaluation, bound queries and serialization.
+ @details Freezing reuses the memory of a previous freeze; doing it every time step is cheap.
+
+ @copyright@parblock
+ Copyright (c) 2017  Carna Radojicic, Christoph Grimm, Design of Cyber-Physical Systems
+ TU Kaiserslautern Postfach 3049 67663 Kaiserslautern radojicic@cs.uni-kl.de
+
+ This file is part of AADD package.
+
+ AADD is free software: you can redistribute it and/or modify it
+ under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ AADD is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public
+ License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with AADD package. If not, see <http://www.gnu.org/licenses/>.
+ @endparblock
+ */
+
+#ifndef aadd_frozen_h
+#define aadd_frozen_h
+
+#include <vector>
+
+#include "aadd.h"
+
+using namespace std;
+
+
+/**
+ @brief An affine form in the coefficient pool of a frozen diagram.
+ @details The noise symbol indexes and deviations are pool entries first .. first+length-1.
+ */
+struct frozenForm
+{
+    double   center;
+    double   offset_min, offset_max;
+    unsigned first;
+    unsigned length;
+};
+
+
+/**
+ @brief A node record of a frozen diagram.
+ @details Internal nodes refer to a condition in the condition table and to the records
+ of their children. Nodes are stored in depth-first order; the root is record 0.
+ Leaves of an AADD refer to a form; leaves of a BDD hold their truth value in form.
+ */
+struct frozenNode
+{
+    unsigned long index;   /** index of condition as in condMgr(); MAXINDEX if leaf */
+    unsigned form;         /** internal: entry in condition table; leaf: form or truth value */
+    unsigned T, F;         /** records of the children; unused if leaf */
+
+    bool isLeaf() const { return index == MAXINDEX; };
+};
+
+
+/**
+ @brief Frozen, flat representation of an AADD or BDD.
+ */
+class FrozenDD
+{
+public:
+    FrozenDD();
+    FrozenDD(const AADD&);
+    FrozenDD(const BDD&);
+
+    // (re-)freezes a diagram; keeps memory of previous freeze.
+    void freeze(const AADD&);
+    void freeze(const BDD&);
+    void clear();
+
+    // rebuilds a decision diagram from the frozen one.
+    AADDNode* thawAADD() const;
+    BDDNode*  thawBDD() const;
+
+    // concrete evaluation
+    double Evaluate(const double* eps, unsigned K) const;
+    vector<double> Evaluate(const double* samples, unsigned M, unsigned K) const;
+    bool EvaluateBDD(const double* eps, unsigned K) const;
+
+    // bounds of the leaves, as in AADD
+    opt_sol GetBothBounds() const;
+    vector<opt_sol> GetAllBounds() const;
+
+    bool isBDD() const                   { return bdd; };
+    unsigned numNodes() const;
+    unsigned numLeaves() const;
+
+    // access to the flat data structures
+    const vector<frozenNode>& getNodes() const     { return nodes; };
+    const vector<frozenForm>& getConds() const     { return conds; };
+    const vector<frozenForm>& getLeaves() const    { return leaves; };
+    const vector<unsigned long>& getCondIndexes() const { return cond_index; };
+    const vector<unsigned>&   getPoolIndexes() const    { return pool_index; };
+    const vector<double>&     getPoolDeviations() const { return pool_dev; };
+
+    AAF getAAF(const frozenForm&) const;   // creates an AAF from a form of the pool.
+
+    // for building a frozen diagram piece by piece, e.g. when loading it.
+    void setBDD(bool b)                         { bdd = b; };
+    unsigned addForm(vector<frozenForm>&, const AAF&);
+    vector<frozenNode>& nodeRecords()           { return nodes; };
+    vector<frozenForm>& condTable()             { return conds; };
+    vector<frozenForm>& leafTable()             { return leaves; };
+    vector<unsigned long>& condIndexes()        { return cond_index; };
+    vector<unsigned>&   poolIndexes()           { return pool_index; };
+    vector<double>&     poolDeviations()        { return pool_dev; };
+
+protected:
+    bool bdd;                          // true if frozen from a BDD.
+    vector<frozenNode> nodes;          // node records; root is nodes[0].
+    vector<frozenForm> conds;          // condition table.
+    vector<frozenForm> leaves;         // leaf forms of an AADD.
+    vector<unsigned>   pool_index;     // packed noise symbol indexes.
+    vector<double>     pool_dev;       // packed deviations.
+    vector<unsigned long> cond_index;  // condition index in condMgr() of each entry of condition table.
+    vector<unsigned>   slot_of;        // scratch: entry in condition table of a condition index.
+
+    template<class ValT> unsigned freezeNode(const DDNode<ValT>*);
+    unsigned condSlot(unsigned long index);
+    unsigned addLeaf(const DDNode<AAF>*);
+    unsigned addLeaf(const DDNode<bool>*);
+
+    template<class NodeT> NodeT* thaw(unsigned rec) const;
+
+    void findBounds(unsigned rec, vector<constraint<AAF> >& cons, vector<opt_sol>& res) const;
+};
+
+#endif /* aadd_frozen_h */
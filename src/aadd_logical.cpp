@@ -231,6 +231,7 @@ BDDNode* BDD::ApplyBinOp(BDD_AOP op, BDDNode*f, BDDNode* g) const
     unsigned long index;
     
     /* Check terminal cases */
+    AADD_STAT_INC(apply_calls);
     res = (*op)(f,g);
     if (res != nullptr) return(res);
     
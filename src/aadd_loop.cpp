@@ -0,0 +1,199 @@
+/**
+
+ @file aadd_loop.cpp
+
+ @ingroup AADD
+
+ @brief Analysis of whileS loops with uncertain trip counts.
+
+ @copyright@parblock
+ Copyright (c) 2017  Carna Radojicic, Christoph Grimm, Design of Cyber-Physical Systems
+ TU Kaiserslautern Postfach 3049 67663 Kaiserslautern radojicic@cs.uni-kl.de
+
+ This file is part of AADD package.
+
+ AADD is free software: you can redistribute it and/or modify it
+ under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ AADD is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public
+ License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with AADD package. If not, see <http://www.gnu.org/licenses/>.
+ @endparblock
+ */
+
+#include <sstream>
+
+#include "aadd.h"
+#include "aadd_loop.h"
+
+
+//@short options of the analysis; off by default.
+loop_options& loopOptions()
+{
+    static thread_local loop_options options = { false, 10, 1000 };
+    return options;
+}
+
+loop_counters& loopCounters()
+{
+    static thread_local loop_counters counters = { 0, 0, 0, 0 };
+    return counters;
+}
+
+
+loopScope::loopScope(const char* f, unsigned l, initializer_list<reference_wrapper<AADD> > vars)
+{
+    file = f;
+    line = l;
+    iterations = 0;
+    widenings = 0;
+    for (const reference_wrapper<AADD>& v: vars) state.push_back(&v.get());
+    if (loopOptions().analysis) loopCounters().loops++;
+}
+
+loopScope::~loopScope()
+{
+    for (unsigned i=0; i < previous.size(); i++) delete previous[i];
+}
+
+
+/**
+ @brief Returns true if two diagrams are the same, with the same conditions and leaves.
+ @details Leaves are compared exactly, including their offsets; operator== of AAF has a
+ tolerance and would end a loop whose state still changes a little.
+ */
+static bool sameNode(const DDNode<AAF>* f, const DDNode<AAF>* g)
+{
+    if (f->getIndex() != g->getIndex()) return false;
+    if (f->isLeaf()) return f->getValue().isIdentical(g->getValue());
+    return sameNode(f->getT(), g->getT()) and sameNode(f->getF(), g->getF());
+}
+
+
+/**
+ @brief Returns true if the last iteration did not change any variable of the state.
+ */
+bool loopScope::unchanged() const
+{
+    if (previous.size() != state.size()) return false;
+    for (unsigned i=0; i < state.size(); i++)
+        if (!sameNode(state[i]->getRoot(), previous[i]->getRoot())) return false;
+    return true;
+}
+
+
+/**
+ @brief Returns true if the bounds of the state are in the joined ranges.
+ */
+bool loopScope::enclosed(const vector<opt_sol>& bounds) const
+{
+    if (lo.size() != state.size()) return false;
+    for (unsigned i=0; i < state.size(); i++)
+        if (bounds[i].min < lo[i] or bounds[i].max > hi[i]) return false;
+    return true;
+}
+
+
+/**
+ @brief Joins the state: each variable is replaced by its range, which is widened if it grows.
+ @details A bound that grows is moved by the growth, but at least by twice its last widening,
+ so that a state that grows steadily is enclosed after a few iterations. The range of a
+ variable keeps the noise symbol of its first join.
+ */
+void loopScope::widen(const vector<opt_sol>& bounds)
+{
+    if (lo.empty())
+    {
+        for (unsigned i=0; i < state.size(); i++)
+        {
+            lo.push_back(bounds[i].min);
+            hi.push_back(bounds[i].max);
+        }
+        grow_lo.assign(state.size(), 0.0);
+        grow_hi.assign(state.size(), 0.0);
+        for (unsigned i=0; i < state.size(); i++)
+        {
+            AAF::setDefault(AAF::getDefault()+1);
+            symbols.push_back(AAF::getDefault());
+        }
+    }
+    else for (unsigned i=0; i < state.size(); i++)
+    {
+        if (bounds[i].min < lo[i])
+        {
+            grow_lo[i] = max(lo[i]-bounds[i].min, 2.0*grow_lo[i]);
+            lo[i] = bounds[i].min-grow_lo[i];
+        }
+        if (bounds[i].max > hi[i])
+        {
+            grow_hi[i] = max(bounds[i].max-hi[i], 2.0*grow_hi[i]);
+            hi[i] = bounds[i].max+grow_hi[i];
+        }
+    }
+
+    for (unsigned i=0; i < state.size(); i++)
+    {
+        double center = (lo[i]+hi[i])/2, radius = (hi[i]-lo[i])/2;
+        *state[i] = AADD(AAF(center, &radius, &symbols[i], 1));
+    }
+    widenings++;
+    loopCounters().widenings++;
+}
+
+
+/**
+ @brief Decides before each iteration if the loop continues.
+ @param cond true if the condition of the loop is not false on all paths.
+ @return true if the loop body is executed once more.
+ */
+bool loopScope::test(bool cond)
+{
+    const loop_options& options = loopOptions();
+    if (!cond or !options.analysis) return cond;
+
+    // an iteration that did not change the state will not change it again.
+    if (!state.empty() and unchanged())
+    {
+        loopCounters().fixed_points++;
+        return false;
+    }
+
+    if (iterations >= options.max_iterations)
+    {
+        std::ostringstream msg;
+        msg << "whileS: no fixed point after " << iterations << " iterations";
+        throw AADD_Exception(AADD_LOOP_EXCEPTION, msg.str(), line, file);
+    }
+
+    if (!state.empty() and iterations >= options.widen_after)
+    {
+        vector<opt_sol> bounds;
+        for (unsigned i=0; i < state.size(); i++) bounds.push_back(state[i]->GetBothBounds());
+
+        // the last iteration stayed in the ranges; they enclose all further ones.
+        if (widenings > 0 and enclosed(bounds))
+        {
+            loopCounters().fixed_points++;
+            return false;
+        }
+        widen(bounds);
+    }
+
+    // the state before the iteration, to detect that it does not change.
+    for (unsigned i=0; i < state.size(); i++)
+    {
+        if (i < previous.size()) delete previous[i];
+        else previous.push_back(nullptr);
+        previous[i] = new AADD(*state[i]);
+    }
+
+    iterations++;
+    loopCounters().iterations++;
+    return true;
+}
@@ -0,0 +1,122 @@
+/**
+
+ @file aadd_loop.h
+
+ @ingroup AADD
+
+ @brief Analysis of whileS loops with uncertain trip counts.
+
+ @details whileS iterates as long as its condition is not false on all paths. With uncertain
+ data, this can take many iterations or never end, and each iteration adds nodes. With
+ loopOptions().analysis, a loop is analysed instead:
+ - the loop ends if its state did not change in an iteration;
+ - after widen_after iterations, the state is joined: each variable is replaced by the range
+   of its values. If the range grows, it is widened by twice the growth of the last widening.
+   The loop ends when the next iteration stays in the range; then the range encloses the
+   values in all further iterations;
+ - a loop that does not end within max_iterations throws an AADD_Exception.
+ The joined range of a variable uses one noise symbol per loop, so that the widenings of a loop
+ do not add new noise symbols.
+ @details Only whileStateS(cond, a, b, ...) is analysed: its arguments are the state. A plain
+ whileS has no state; it gets neither the fixed point test nor widening, and is only limited by
+ max_iterations. Without analysis, both are the same as before.
+
+ @copyright@parblock
+ Copyright (c) 2017  Carna Radojicic, Christoph Grimm, Design of Cyber-Physical Systems
+ TU Kaiserslautern Postfach 3049 67663 Kaiserslautern radojicic@cs.uni-kl.de
+
+ This file is part of AADD package.
+
+ AADD is free software: you can redistribute it and/or modify it
+ under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ AADD is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public
+ License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with AADD package. If not, see <http://www.gnu.org/licenses/>.
+ @endparblock
+ */
+
+#ifndef aadd_loop_h
+#define aadd_loop_h
+
+#include <vector>
+#include <functional>
+#include <initializer_list>
+
+using namespace std;
+
+class AADD;
+struct opt_sol;
+
+
+/**
+ @brief Options of the analysis of loops.
+ @details The options are per thread.
+ */
+struct loop_options
+{
+    bool analysis;                  // off: whileS iterates until its condition is false;
+                                    // on: whileStateS is analysed, whileS only limited
+    unsigned widen_after;           // iterations before the state is joined and widened
+    unsigned max_iterations;        // iterations after which an exception is thrown
+};
+
+loop_options& loopOptions();
+
+
+/**
+ @brief Counters of the analysis of loops; they can be reset by assigning zero.
+ @details The counters are per thread.
+ */
+struct loop_counters
+{
+    unsigned long loops;            // loops started with analysis
+    unsigned long iterations;       // iterations of these loops
+    unsigned long widenings;        // joins resp. widenings of a loop state
+    unsigned long fixed_points;     // loops ended by an unchanged or enclosed state
+};
+
+loop_counters& loopCounters();
+
+
+/**
+ @brief One execution of a whileS or whileStateS loop.
+ @details Created by the macros; test is called with the value of the condition before each
+ iteration and decides if the loop continues.
+ */
+class loopScope
+{
+public:
+    loopScope(const char* file, unsigned line,
+              initializer_list<reference_wrapper<AADD> > state = initializer_list<reference_wrapper<AADD> >());
+    ~loopScope();
+
+    bool test(bool cond);
+
+protected:
+    const char* file;
+    unsigned line;
+    unsigned iterations;
+    unsigned widenings;
+    vector<AADD*> state;            // the variables of the loop
+    vector<AADD*> previous;         // their values before the last iteration
+    vector<double> lo, hi;          // joined ranges of the variables
+    vector<double> grow_lo, grow_hi; // widening of the ranges in the last step
+    vector<unsigned> symbols;       // noise symbols of the joined ranges
+
+    bool unchanged() const;
+    bool enclosed(const vector<opt_sol>& bounds) const;
+    void widen(const vector<opt_sol>& bounds);
+
+private:
+    loopScope(const loopScope&);
+    loopScope& operator=(const loopScope&);
+};
+
+#endif /* aadd_loop_h */
@@ -0,0 +1,196 @@
+/**
+
+ @file aadd_lp_backend.cpp
+
+ @ingroup AADD
+
+ @brief Interface of the LP solvers that compute the bounds of AADD; GLPK backend.
+
+ @copyright@parblock
+ Copyright (c) 2017  Carna Radojicic, Christoph Grimm, Design of Cyber-Physical Systems
+ TU Kaiserslautern Postfach 3049 67663 Kaiserslautern radojicic@cs.uni-kl.de
+
+ This file is part of AADD package.
+
+ AADD is free software: you can redistribute it and/or modify it
+ under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ AADD is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public
+ License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with AADD package. If not, see <http://www.gnu.org/licenses/>.
+ @endparblock
+ */
+
+#include <assert.h>
+#include <math.h>
+
+#include "aadd_lp_backend.h"
+#include "aa_rounding.h"
+
+
+GLPKBackend::GLPKBackend()
+{
+    lp = nullptr;
+    n = m = 0;
+    iters = 0;
+    last_dir = GLP_MAX;
+
+    glp_init_smcp(&param);
+#ifdef AADD_DEBUG
+    param.msg_lev = GLP_MSG_ERR; // error and warning messages
+#else
+    param.msg_lev = GLP_MSG_OFF; // no output
+#endif
+}
+
+GLPKBackend::~GLPKBackend()
+{
+    if (lp != nullptr) glp_delete_prob(lp);
+}
+
+
+/**
+ @brief Creates a new GLPK problem with the nominal value column and n columns in [-1,1].
+ */
+void GLPKBackend::reset(unsigned cols)
+{
+    if (lp != nullptr) glp_delete_prob(lp);
+    lp = glp_create_prob();
+    n = cols;
+    m = 0;
+
+    glp_add_cols(lp, n+1);
+    glp_set_col_bnds(lp, 1, GLP_FX, 1.0, 1.0);
+    for (unsigned j=2; j <= n+1; j++)
+        glp_set_col_bnds(lp, j, GLP_DB, -1.0, 1.0);
+
+    ind.resize(n+2);
+    val.resize(n+2);
+}
+
+
+/**
+ @brief Adds the row a'e - rhs <= 0; zero coefficients are not passed to GLPK.
+ */
+void GLPKBackend::addRow(const double* a, double rhs)
+{
+    int len = 1;
+    ind[1] = 1;
+    val[1] = -rhs;
+    for (unsigned j=0; j < n; j++)
+        if (a[j] != 0.0)
+        {
+            len++;
+            ind[len] = j+2;
+            val[len] = a[j];
+        }
+
+    glp_add_rows(lp, 1);
+    m++;
+    glp_set_row_bnds(lp, m, GLP_UP, 0.0, 0.0);
+    glp_set_mat_row(lp, m, len, &ind[0], &val[0]);
+}
+
+
+void GLPKBackend::removeRow()
+{
+    assert(m > 0);
+    int num[2] = { 0, (int) m };
+    glp_del_rows(lp, 1, num);
+    m--;
+}
+
+
+void GLPKBackend::setObjective(const double* c, double c0)
+{
+    glp_set_obj_coef(lp, 1, c0);
+    for (unsigned j=0; j < n; j++)
+        glp_set_obj_coef(lp, j+2, c[j]);
+}
+
+
+lp_status GLPKBackend::solve(int dir, double& value)
+{
+    if (!warm_start) glp_std_basis(lp);
+
+    int before = glp_get_it_cnt(lp);
+    last_dir = dir;
+    glp_set_obj_dir(lp, dir);
+    int err = glp_simplex(lp, &param);
+    iters = glp_get_it_cnt(lp)-before;
+
+    // the value is also set if GLPK does not find an optimum, as solve_lp always did.
+    value = glp_get_obj_val(lp);
+    if (err != 0) return LP_FAILED;
+
+    switch (glp_get_status(lp))
+    {
+        case GLP_OPT:    return LP_OPTIMAL;
+        case GLP_NOFEAS: return LP_INFEASIBLE;
+        default:         return LP_FAILED;
+    }
+}
+
+lp_status GLPKBackend::maximize(double& value)
+{
+    return solve(GLP_MAX, value);
+}
+
+lp_status GLPKBackend::minimize(double& value)
+{
+    return solve(GLP_MIN, value);
+}
+
+
+/**
+ @brief Row duals of GLPK, with the sign of max of the last solve.
+ */
+bool GLPKBackend::getDuals(vector<double>& y) const
+{
+    if (lp == nullptr or glp_get_status(lp) != GLP_OPT) return false;
+
+    const double sign = last_dir == GLP_MAX ? 1.0 : -1.0;
+    y.resize(m);
+    for (unsigned i=0; i < m; i++)
+        y[i] = sign*glp_get_row_dual(lp, i+1);
+    return true;
+}
+
+
+double certifiedMax(unsigned n, unsigned m, const double* A, const double* r, const double* c,
+                    double c0, const double* y)
+{
+    static thread_local vector<double> lo, hi;
+    aa_rnd_t mode = aa_fegetround();
+
+    // enclosure [lo, hi] of the reduced costs c - A'y
+    lo.assign(c, c+n);
+    hi.assign(c, c+n);
+    aa_fesetround(AA_DOWNWARD);
+    for (unsigned i=0; i < m; i++)
+    {
+        if (!(y[i] > 0.0)) continue;
+        for (unsigned j=0; j < n; j++) lo[j] += (-A[i*n+j])*y[i];
+    }
+    aa_fesetround(AA_UPWARD);
+    for (unsigned i=0; i < m; i++)
+    {
+        if (!(y[i] > 0.0)) continue;
+        for (unsigned j=0; j < n; j++) hi[j] += (-A[i*n+j])*y[i];
+    }
+
+    double bound = c0;
+    for (unsigned i=0; i < m; i++)
+        if (y[i] > 0.0) bound += y[i]*r[i];
+    for (unsigned j=0; j < n; j++)
+        bound += fabs(lo[j]) > fabs(hi[j]) ? fabs(lo[j]) : fabs(hi[j]);
+
+    aa_fesetround(mode);
+    return bound;
+}
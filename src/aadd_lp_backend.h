@@ -0,0 +1,153 @@
+/**
+
+ @file aadd_lp_backend.h
+
+ @ingroup AADD
+
+ @brief Interface of the LP solvers that compute the bounds of AADD.
+
+ @details The LPs of solve_lp have noise symbols boxed in [-1,1] as columns and the path
+ conditions as rows:
+ @verbatim
+   max/min c'e + c0   s.t.  A e <= r,  -1 <= e <= 1
+ @endverbatim
+ LPBackend is the interface of a solver for them. A problem is created by reset, rows are
+ added and removed at its end, and the objective can be changed between solves. With warm
+ start, a solve starts from the basis of the previous one if it is still usable, e.g. after
+ adding rows or changing the objective.
+ @details The multipliers of the rows from a solve certify its result; certifiedMax computes
+ a rigorous bound from them.
+ @details Two backends are part of the library: GLPKBackend and the in-library BoxSimplex.
+ solve_lp selects them by lpOptions(); an application can also provide its own backend there.
+
+ @copyright@parblock
+ Copyright (c) 2017  Carna Radojicic, Christoph Grimm, Design of Cyber-Physical Systems
+ TU Kaiserslautern Postfach 3049 67663 Kaiserslautern radojicic@cs.uni-kl.de
+
+ This file is part of AADD package.
+
+ AADD is free software: you can redistribute it and/or modify it
+ under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ AADD is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public
+ License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with AADD package. If not, see <http://www.gnu.org/licenses/>.
+ @endparblock
+ */
+
+#ifndef aadd_lp_backend_h
+#define aadd_lp_backend_h
+
+#include <vector>
+
+#include "glpk.h"
+
+using namespace std;
+
+
+/**
+ @brief Result of solving an LP.
+ */
+enum lp_status
+{
+    LP_OPTIMAL,      // solved; value is the optimum.
+    LP_INFEASIBLE,   // the constraints cannot be satisfied in the box.
+    LP_FAILED        // iteration limit or numerical problems; use another solver.
+};
+
+
+/**
+ @brief Solver of LPs max/min c'e + c0, A e <= r, e in [-1,1]^n.
+ */
+class LPBackend
+{
+public:
+    LPBackend(): warm_start(true) {};
+    virtual ~LPBackend() {};
+
+    virtual const char* name() const = 0;
+
+    virtual void reset(unsigned n) = 0;                    // new problem with n columns and no rows.
+    virtual void addRow(const double* a, double rhs) = 0;  // adds a[0..n-1]'e <= rhs.
+    virtual void removeRow() = 0;                          // removes the last row.
+    virtual void setObjective(const double* c, double c0=0.0) = 0;  // sets c[0..n-1] and the constant c0.
+
+    virtual lp_status maximize(double& value) = 0;
+    virtual lp_status minimize(double& value) = 0;
+
+    virtual unsigned numRows() const = 0;
+    virtual unsigned numCols() const = 0;
+    virtual unsigned iterations() const = 0;               // pivots of the last solve.
+
+    // multipliers y >= 0 of the rows from the last solve; false if there are none.
+    virtual bool getDuals(vector<double>&) const           { return false; };
+
+    void setWarmStart(bool on)                  { warm_start = on; };
+    bool getWarmStart() const                   { return warm_start; };
+
+protected:
+    bool warm_start;
+};
+
+
+/**
+ @brief Backend that solves the LP with GLPK.
+ @details The GLPK problem object is kept until the next reset; GLPK starts each solve from
+ the basis of the last one, or from the standard basis if warm start is off. As in the model
+ solve_lp always used, column 1 is the nominal value fixed to 1; it carries the right hand
+ sides and the constant of the objective.
+ */
+class GLPKBackend: public LPBackend
+{
+public:
+    GLPKBackend();
+    ~GLPKBackend();
+
+    const char* name() const                    { return "glpk"; };
+
+    void reset(unsigned n);
+    void addRow(const double* a, double rhs);
+    void removeRow();
+    void setObjective(const double* c, double c0=0.0);
+
+    lp_status maximize(double& value);
+    lp_status minimize(double& value);
+
+    unsigned numRows() const                    { return m; };
+    unsigned numCols() const                    { return n; };
+    unsigned iterations() const                 { return iters; };
+    bool getDuals(vector<double>& y) const;
+
+protected:
+    glp_prob* lp;
+    glp_smcp param;
+    unsigned n, m;
+    unsigned iters;
+    int last_dir;                  // direction of the last solve
+    vector<int> ind;               // buffers for the rows, 1-based as GLPK
+    vector<double> val;
+
+    lp_status solve(int dir, double& value);
+
+private:
+    GLPKBackend(const GLPKBackend&);            // not copyable
+    GLPKBackend& operator=(const GLPKBackend&);
+};
+
+
+/**
+ @brief Rigorous upper bound of max c'e + c0, A e <= r, e in [-1,1]^n from multipliers y.
+ @details By weak duality, c'e <= y'r + sum_j |c_j - (A'y)_j| for all feasible e and y >= 0.
+ The bound is computed with outward rounding; negative multipliers are taken as 0. It is
+ tight if y are the optimal duals, and sound for any y.
+ */
+double certifiedMax(unsigned n, unsigned m, const double* A, const double* r, const double* c,
+                    double c0, const double* y);
+
+#endif /* aadd_lp_backend_h */
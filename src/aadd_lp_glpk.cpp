@@ -39,17 +39,39 @@
 
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <math.h>
+#include <string.h>
 #include <algorithm>    // std::set_union, std::sort
 #include <vector>       // std::vector
+#include <chrono>
 
 #include "aadd.h"
+#include "aadd_lp_simplex.h"
+#include "aadd_box.h"
+#include "aa_rounding.h"
 
 
 
+/**
+ @brief Adds empty bounds for the leaves of a path that cannot hold.
+ @details min > max, so that they do not change the total bounds.
+ */
+static void prune(unsigned leaves, vector<opt_sol>& res)
+{
+    opt_sol none;
+    none.max = -HUGE_VAL;
+    none.min = HUGE_VAL;
+    res.insert(res.end(), leaves, none);
+    AADD_STAT_INC(box_pruned);
+}
+
+
 /**
  @brief Private Method of AADD that finds bounds of AAFs in AADD's leaves
  @details Method is called by GetMin(), GetMax() and GetBothBounds()
+ @details With lpOptions().contract_boxes, the box of the noise symbols is contracted by the
+ conditions on the path; leaves on paths whose box is empty get empty bounds without an LP.
  @author Carna Radojicic
  @return vector of optimal solutions including lower and upper bounds
  @see GetMin(), GetMax() and GetBothBounds()
@@ -63,7 +85,7 @@ vector<opt_sol> AADD::FindBounds(AADDNode* f, vector<constraint<AAF> > constrain
     
     if (f->isLeaf() ) {
         
-        opt_sol bounds=solve_lp(f->getValue(), constraints);
+        opt_sol bounds=solve_lp(*f, constraints);
         res.push_back(bounds);
         return res;
     }
@@ -76,13 +98,20 @@ vector<opt_sol> AADD::FindBounds(AADDNode* f, vector<constraint<AAF> > constrain
     cons.con=f->getCond();
     cons.sign='+';
     
+    const bool boxes = lpOptions().contract_boxes;
+    if (boxes and constraints.empty()) noiseBox().reset();
+    
     constraints.push_back(cons);
     
-    res=FindBounds(fv,constraints, res);
+    if (!boxes or noiseBox().push(cons.con, '+')) res=FindBounds(fv,constraints, res);
+    else prune(numLeaves(*fv), res);
+    if (boxes) noiseBox().pop();
     
     constraints.back().sign='-';
     
-    res=FindBounds(fvn,constraints, res);
+    if (!boxes or noiseBox().push(cons.con, '-')) res=FindBounds(fvn,constraints, res);
+    else prune(numLeaves(*fvn), res);
+    if (boxes) noiseBox().pop();
     
     return res;
     
@@ -182,6 +211,544 @@ vector<opt_sol> AADD::GetAllBounds() const
 } // AADD::GetAllBounds
 
 
+static unsigned long long bounds_key(const vector<constraint<AAF> >& constraints,
+                                     vector<unsigned long long>& data);
+
+
+/**
+ @brief Recursion of GetBothBounds of several AADD.
+ @details The current nodes of the k AADD are stack[base .. base+k-1], as in ApplyNaryOp.
+ At the end of each path, the bounds of the k leaves are computed on one LP and joined into res,
+ unless all of them are cached.
+ */
+static void FindBoundsNary(vector<AADDNode*>& stack, size_t base, unsigned k,
+                           vector<constraint<AAF> >& constraints, vector<const AAF*>& vals,
+                           vector<opt_sol>& res, bool& first)
+{
+    unsigned long index = MAXINDEX;
+
+    for (unsigned i=0; i < k; i++)
+        if (stack[base+i]->getIndex() < index) index = stack[base+i]->getIndex();
+
+    /* Terminal case: all nodes are leaves. */
+    if (index == MAXINDEX)
+    {
+        vector<opt_sol> bounds(k);
+        static thread_local vector<unsigned long long> data;
+        bool cached = lpOptions().cache_bounds and !lpOptions().verified;
+        unsigned long long key = cached ? bounds_key(constraints, data) : 0;
+        for (unsigned i=0; i < k and cached; i++)
+        {
+            const leaf_bounds* c = stack[base+i]->getBounds();
+            cached = c != nullptr and c->key == key and c->data == data;
+            if (cached)
+            {
+                bounds[i].min = c->min;
+                bounds[i].max = c->max;
+            }
+        }
+        if (cached) AADD_STAT_ADD(lp_cache_hits, k);
+        else
+        {
+            for (unsigned i=0; i < k; i++) vals[i] = &stack[base+i]->getValue();
+            bounds = solve_lp(vals, constraints);
+        }
+        for (unsigned i=0; i < k; i++)
+        {
+            if (first or bounds[i].min < res[i].min) res[i].min = bounds[i].min;
+            if (first or bounds[i].max > res[i].max) res[i].max = bounds[i].max;
+        }
+        first = false;
+        return;
+    }
+
+    /* Recursive step; nodes with other index are kept. Paths that cannot hold are pruned. */
+    const bool boxes = lpOptions().contract_boxes;
+    if (boxes and constraints.empty()) noiseBox().reset();
+
+    constraint<AAF> cons;
+    cons.con = condMgr().getCond(index);
+    cons.sign = '+';
+    constraints.push_back(cons);
+
+    size_t top = base+k;
+    stack.resize(top+k);
+    for (unsigned i=0; i < k; i++)
+    {
+        AADDNode* f = stack[base+i];
+        stack[top+i] = (f->getIndex() == index) ? f->getT() : f;
+    }
+    if (!boxes or noiseBox().push(cons.con, '+')) FindBoundsNary(stack, top, k, constraints, vals, res, first);
+    else AADD_STAT_INC(box_pruned);
+    if (boxes) noiseBox().pop();
+
+    constraints.back().sign = '-';
+    stack.resize(top+k);
+    for (unsigned i=0; i < k; i++)
+    {
+        AADDNode* f = stack[base+i];
+        stack[top+i] = (f->getIndex() == index) ? f->getF() : f;
+    }
+    if (!boxes or noiseBox().push(cons.con, '-')) FindBoundsNary(stack, top, k, constraints, vals, res, first);
+    else AADD_STAT_INC(box_pruned);
+    if (boxes) noiseBox().pop();
+
+    constraints.pop_back();
+}
+
+
+/**
+ @brief Total lower and upper bounds of several AADD, e.g. the state variables of a model.
+ @details The AADD are traversed simultaneously as by apply; each path of their common
+ decision structure is set up once as an LP, which is then optimized for the leaves of all
+ AADD on it. The bounds are those of GetBothBounds on an LP whose columns are the noise
+ symbols of all leaves of the path; they may be slightly wider than GetBothBounds of each AADD.
+ @return the bounds of vars[i] in element i
+ */
+vector<opt_sol> GetBothBounds(const vector<const AADD*>& vars)
+{
+    unsigned k = vars.size();
+    vector<opt_sol> res(k);
+    vector<AADDNode*> stack;
+    vector<constraint<AAF> > constraints;
+    vector<const AAF*> vals(k);
+    bool first = true;
+
+    if (k == 0) return res;
+    for (unsigned i=0; i < k; i++) stack.push_back(vars[i]->getRoot());
+    stack.reserve(4*k);
+    FindBoundsNary(stack, 0, k, constraints, vals, res, first);
+    return res;
+}
+
+vector<opt_sol> GetBothBounds(const vector<AADD>& vars)
+{
+    vector<const AADD*> ptrs;
+    for (unsigned i=0; i < vars.size(); i++) ptrs.push_back(&vars[i]);
+    return GetBothBounds(ptrs);
+}
+
+
+//@short counters of solved LPs; one instance per thread.
+lp_counters& lpCounters()
+{
+    static thread_local lp_counters counters = { 0, 0.0 };
+    return counters;
+}
+
+
+/**
+ @brief Options of solve_lp; one instance per thread.
+ @details The solver is initialized from the environment variable AADD_LP_SOLVER,
+ which may be auto, builtin, glpk or compare.
+ */
+lp_options& lpOptions()
+{
+    static thread_local lp_options options = { LP_SOLVER_AUTO, 32, 512, true, true, false, 1e-6, false, false, nullptr };
+    static thread_local bool initialized = false;
+
+    if (!initialized)
+    {
+        initialized = true;
+        const char* env = getenv("AADD_LP_SOLVER");
+        if (env != nullptr)
+        {
+            string name(env);
+            if (name == "builtin")      options.solver = LP_SOLVER_BUILTIN;
+            else if (name == "glpk")    options.solver = LP_SOLVER_GLPK;
+            else if (name == "compare") options.solver = LP_SOLVER_COMPARE;
+        }
+    }
+    return options;
+}
+
+
+//@short results of the comparison of the solvers; one instance per thread.
+lp_comparison& lpComparison()
+{
+    static thread_local lp_comparison comparison = { 0, 0, 0.0, 0.0, 0.0 };
+    return comparison;
+}
+
+
+//@short results of the verification of bounds; one instance per thread.
+lp_verification& lpVerification()
+{
+    static thread_local lp_verification verification = { 0, 0, false };
+    return verification;
+}
+
+
+//@short the backends of the library; one instance per thread.
+static GLPKBackend& glpkBackend()
+{
+    static thread_local GLPKBackend backend;
+    return backend;
+}
+
+static BoxSimplex& builtinBackend()
+{
+    static thread_local BoxSimplex backend;
+    return backend;
+}
+
+
+/**
+ @brief The LP of solve_lp in the form of LPBackend.
+ */
+struct bound_lp
+{
+    unsigned n, m;
+    vector<double> A, r;           // rows A e <= r
+    vector<double> c;              // objective c'e + c0
+    double c0;
+    double offset_min, offset_max; // added to the minimum and maximum
+};
+
+
+/**
+ @brief Sets the objective of lp to var1 on the columns idx[0..len-1].
+ @details The center of var1 is the constant of the objective; symbols of var1 that are not
+ columns are ignored.
+ */
+static void setup_objective(bound_lp& lp, const AAF& var1, const unsigned* idx, unsigned len)
+{
+    const unsigned* id1 = var1.getIndexes();
+    unsigned a = 0;
+
+    lp.c.assign(len, 0.0);
+    for (unsigned k=0; k < len; k++)
+    {
+        while (a < var1.getlength() and id1[a] < idx[k]) a++;
+        if (a < var1.getlength() and id1[a] == idx[k]) lp.c[k] = var1[a+1];
+    }
+    lp.c0 = var1.getcenter();
+    lp.offset_min = var1.offset_min;
+    lp.offset_max = var1.offset_max;
+}
+
+
+/**
+ @brief Sets up the LP of solve_lp on the columns idx[0..len-1].
+ @details The nominal value is moved to the right hand side: a constraint with sign '-' is
+ (center+offset_min) + a'e <= 0, one with sign '+' is (center+offset_max) + a'e >= 0.
+ The objective is var1, see setup_objective.
+ */
+static bound_lp& setup_lp(const AAF& var1, const vector<constraint<AAF> >& constraints,
+                          const unsigned* idx, unsigned len)
+{
+    static thread_local bound_lp lp;
+
+    lp.n = len;
+    lp.m = constraints.size();
+    lp.A.assign(lp.m*len, 0.0);
+    lp.r.resize(lp.m);
+
+    for (unsigned j=0; j < lp.m; j++)
+    {
+        const AAF& con = constraints[j].con;
+        const double s = constraints[j].sign == '-' ? 1.0 : -1.0;
+        const unsigned* id = con.getIndexes();
+        double* row = &lp.A[j*len];
+        unsigned b = 0;
+
+        for (unsigned k=0; k < len; k++)
+        {
+            while (b < con.getlength() and id[b] < idx[k]) b++;
+            if (b < con.getlength() and id[b] == idx[k]) row[k] = s*con[b+1];
+        }
+        lp.r[j] = s > 0 ? -(con.getcenter()+con.offset_min) : con.getcenter()+con.offset_max;
+    }
+
+    setup_objective(lp, var1, idx, len);
+    return lp;
+}
+
+
+// true if the bounds of the last call of solve_lp_with are certified.
+static thread_local bool last_certified = false;
+
+
+/**
+ @brief Replaces the optimum of the last solve of lp by a rigorous bound from its duals.
+ @param sign 1 for a maximum, -1 for a minimum.
+ @return false if the backend has no duals or the bound is worse than the optimum by more
+ than lpOptions().verify_tolerance; the bound is still rigorous if there are duals.
+ */
+static bool certify(const LPBackend& lp, const bound_lp& p, double sign, lp_status status, double& value)
+{
+    static thread_local vector<double> y, c;
+
+    if (status != LP_OPTIMAL or !lp.getDuals(y)) return false;
+
+    c.resize(p.n);
+    for (unsigned j=0; j < p.n; j++) c[j] = sign*p.c[j];
+    double bound = certifiedMax(p.n, p.m, &p.A[0], &p.r[0], &c[0], sign*p.c0, &y[0]);
+
+    // the certificate of the maximum of sign*(c'e + c0)
+    double gap = bound-sign*value;
+    if (!(gap < HUGE_VAL)) return false;
+    value = sign*bound;
+    return gap <= lpOptions().verify_tolerance*(1.0+fabs(value));
+}
+
+
+/**
+ @brief Solves the LP of solve_lp with the backend lp.
+ @details The bounds are set from the values the backend returns, even if it did not find
+ an optimum. With lpOptions().verified, they are replaced by rigorous bounds from the duals
+ and the offsets are added with outward rounding.
+ @return LP_OPTIMAL if both the maximum and the minimum have been found.
+ */
+static lp_status solve_lp_with(LPBackend& lp, const bound_lp& p, opt_sol& res)
+{
+    const bool verify = lpOptions().verified;
+
+    lp.reset(p.n);
+    for (unsigned j=0; j < p.m; j++)
+        lp.addRow(&p.A[j*p.n], p.r[j]);
+    lp.setObjective(&p.c[0], p.c0);
+
+    double max = 0.0, min = 0.0;
+    lp_status smax = lp.maximize(max);
+    unsigned iterations = lp.iterations();
+    last_certified = verify and certify(lp, p, 1.0, smax, max);
+    lp_status smin = lp.minimize(min);
+    iterations += lp.iterations();
+    last_certified = verify and certify(lp, p, -1.0, smin, min) and last_certified;
+
+    if (verify)
+    {
+        aa_rnd_t mode = aa_fegetround();
+        aa_fesetround(AA_UPWARD);
+        res.max = max+p.offset_max;
+        aa_fesetround(AA_DOWNWARD);
+        res.min = min+p.offset_min;
+        aa_fesetround(mode);
+    }
+    else
+    {
+        res.max = max+p.offset_max;
+        res.min = min+p.offset_min;
+    }
+    AADD_STAT_ADD(simplex_iterations, iterations);
+    return smax != LP_OPTIMAL ? smax : smin;
+}
+
+
+/**
+ @brief Computes the bounds of an LP with at most two rows in closed form.
+ @return false if there is no closed form; res is not changed then.
+ @see closedFormMax
+ */
+static bool solve_closed_form(const bound_lp& p, opt_sol& res)
+{
+    static thread_local vector<double> e, neg;
+    double max, min;
+
+    if (p.m > 2) return false;
+    e.resize(p.n);
+    neg.resize(p.n);
+    for (unsigned j=0; j < p.n; j++) neg[j] = -p.c[j];
+
+    if (not closedFormMax(p.n, p.m, &p.A[0], &p.r[0], &p.c[0], &e[0], max)) return false;
+    if (not closedFormMax(p.n, p.m, &p.A[0], &p.r[0], &neg[0], &e[0], min)) return false;
+
+    res.max = p.c0+max+p.offset_max;
+    res.min = p.c0-min+p.offset_min;
+    return true;
+}
+
+
+//@short true if the bounds agree up to the tolerance of the solvers.
+static bool sameBounds(const opt_sol& a, const opt_sol& b, double& diff)
+{
+    diff = max(fabs(a.max-b.max), fabs(a.min-b.min));
+    double scale = 1.0+max(max(fabs(a.max), fabs(a.min)), max(fabs(b.max), fabs(b.min)));
+    return diff <= 1e-6*scale;
+}
+
+
+/**
+ @brief Presolve: splits the LP into the independent blocks that matter for the objective.
+ @details Columns that are in no row take the bound given by the sign of their objective
+ coefficient; they are removed and contribute +-|c_j| to the maximum resp. minimum. The other
+ columns are grouped into the connected components of the rows. A block is a component with
+ a nonzero objective coefficient; the maximum and minimum of the LP are the sums of those of
+ the blocks. Rows of components without objective do not change the bounds of a feasible LP;
+ they are collected in dropped, with a zero objective, so that their feasibility can be checked.
+ @param free_sum receives the sum of |c_j| of the removed columns.
+ @return false if the LP cannot be split, because a row without columns cannot hold.
+ */
+static bool presolve_lp(const bound_lp& p, vector<bound_lp>& blocks, bound_lp& dropped, double& free_sum)
+{
+    static thread_local vector<unsigned> parent, block_of, cols;
+    static thread_local vector<bool> in_row;
+    const double tol = 1e-9;
+
+    parent.resize(p.n);
+    in_row.assign(p.n, false);
+    for (unsigned j=0; j < p.n; j++) parent[j] = j;
+
+    // components of the columns, joined by the rows.
+    for (unsigned i=0; i < p.m; i++)
+    {
+        const double* row = &p.A[i*p.n];
+        unsigned first = p.n;
+        for (unsigned j=0; j < p.n; j++)
+        {
+            if (row[j] == 0.0) continue;
+            in_row[j] = true;
+            if (first == p.n) { first = j; continue; }
+
+            unsigned a = first, b = j;
+            while (parent[a] != a) a = parent[a] = parent[parent[a]];
+            while (parent[b] != b) b = parent[b] = parent[parent[b]];
+            if (a != b) parent[max(a, b)] = min(a, b);
+        }
+        if (first == p.n and p.r[i] < -tol*(1.0+fabs(p.r[i]))) return false;
+    }
+
+    // blocks are the components with objective.
+    const unsigned none = ~0u;
+    unsigned nb = 0;
+    free_sum = 0.0;
+    block_of.assign(p.n, none);
+    for (unsigned j=0; j < p.n; j++)
+    {
+        unsigned root = j;
+        while (parent[root] != root) root = parent[root];
+        parent[j] = root;
+        if (!in_row[j]) free_sum += fabs(p.c[j]);
+        else if (p.c[j] != 0.0 and block_of[root] == none) block_of[root] = nb++;
+    }
+
+    if (blocks.size() < nb) blocks.resize(nb);
+    for (unsigned b=0; b <= nb; b++)
+    {
+        bound_lp& block = (b < nb) ? blocks[b] : dropped;
+        block.n = block.m = 0;
+        block.A.clear();
+        block.r.clear();
+        block.c.clear();
+        block.c0 = block.offset_min = block.offset_max = 0.0;
+    }
+
+    // columns of the blocks, in their order in the LP.
+    cols.assign(p.n, none);
+    for (unsigned j=0; j < p.n; j++)
+    {
+        if (!in_row[j]) continue;
+        bound_lp& block = (block_of[parent[j]] == none) ? dropped : blocks[block_of[parent[j]]];
+        cols[j] = block.n++;
+        block.c.push_back(p.c[j]);
+    }
+    for (unsigned i=0; i < p.m; i++)
+    {
+        const double* row = &p.A[i*p.n];
+        unsigned first = 0;
+        while (first < p.n and row[first] == 0.0) first++;
+        if (first == p.n) continue;
+
+        bound_lp& block = (block_of[parent[first]] == none) ? dropped : blocks[block_of[parent[first]]];
+        block.A.resize((block.m+1)*block.n, 0.0);
+        for (unsigned j=first; j < p.n; j++)
+            if (row[j] != 0.0) block.A[block.m*block.n+cols[j]] = row[j];
+        block.r.push_back(p.r[i]);
+        block.m++;
+    }
+    blocks.resize(nb);
+    return true;
+}
+
+
+/**
+ @brief Solves the LP by the solver selected in lpOptions().
+ @return LP_OPTIMAL if the bounds are optimal.
+ */
+static lp_status solve_bound_lp(const bound_lp& lp, opt_sol& res)
+{
+    const lp_options& options = lpOptions();
+    lp_status status = LP_OPTIMAL;
+
+    if (options.backend != nullptr)
+    {
+        status = solve_lp_with(*options.backend, lp, res);
+    }
+    else if (options.solver == LP_SOLVER_COMPARE)
+    {
+        // GLPK is the reference; its result is returned.
+        opt_sol own;
+        std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+        lp_status builtin = solve_lp_with(builtinBackend(), lp, own);
+        std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+        status = solve_lp_with(glpkBackend(), lp, res);
+        std::chrono::steady_clock::time_point t2 = std::chrono::steady_clock::now();
+        AADD_STAT_INC(glpk_calls);
+
+        lp_comparison& cmp = lpComparison();
+        double diff;
+        cmp.problems++;
+        if (builtin != status)
+            cmp.disagreements++;
+        else if (status == LP_OPTIMAL)
+        {
+            if (!sameBounds(own, res, diff)) cmp.disagreements++;
+            if (diff > cmp.max_difference) cmp.max_difference = diff;
+        }
+        cmp.seconds_builtin += std::chrono::duration<double>(t1-t0).count();
+        cmp.seconds_glpk    += std::chrono::duration<double>(t2-t1).count();
+    }
+    else if (options.closed_form and !options.verified and options.solver != LP_SOLVER_GLPK
+             and solve_closed_form(lp, res))
+    {
+        AADD_STAT_INC(lp_closed_form);
+    }
+    else
+    {
+        // LP_SOLVER_AUTO solves small LP by the in-library solver.
+        bool builtin = options.solver == LP_SOLVER_BUILTIN or
+                       (options.solver == LP_SOLVER_AUTO and lp.m <= options.max_rows
+                        and lp.n <= options.max_cols);
+
+        if (!builtin or solve_lp_with(builtinBackend(), lp, res) != LP_OPTIMAL)
+        {
+            status = solve_lp_with(glpkBackend(), lp, res);
+            AADD_STAT_INC(glpk_calls);
+        }
+    }
+    return status;
+}
+
+
+/**
+ @brief Checks if the rows of an LP can hold in the box, by phase 1 of the solver.
+ @details The solver is selected as in solve_bound_lp; the objective of lp is not used.
+ @return LP_OPTIMAL if the rows are feasible.
+ */
+static lp_status feasible_lp(const bound_lp& lp)
+{
+    const lp_options& options = lpOptions();
+    bool builtin = options.solver == LP_SOLVER_BUILTIN or
+                   (options.solver == LP_SOLVER_AUTO and lp.m <= options.max_rows
+                    and lp.n <= options.max_cols);
+    LPBackend& backend = options.backend != nullptr ? *options.backend :
+                         builtin ? (LPBackend&) builtinBackend() : (LPBackend&) glpkBackend();
+    if (&backend == &glpkBackend()) AADD_STAT_INC(glpk_calls);
+
+    static thread_local vector<double> zero;
+    zero.assign(lp.n, 0.0);
+    backend.reset(lp.n);
+    for (unsigned j=0; j < lp.m; j++)
+        backend.addRow(&lp.A[j*lp.n], lp.r[j]);
+    backend.setObjective(&zero[0], 0.0);
+
+    double value;
+    lp_status status = backend.maximize(value);
+    AADD_STAT_ADD(simplex_iterations, backend.iterations());
+    return status;
+}
+
 
 /**
  
@@ -191,6 +758,11 @@ vector<opt_sol> AADD::GetAllBounds() const
  subject to which LP problem should be solved
  Function is called by relational operators and AADD methods
  GetBothBounds(), GetMin() & GetMax()
+ @details The LP is solved by the backend selected by lpOptions(). GLPK is used
+ if the in-library solver does not find an optimum. LP with up to two constraints are
+ solved in closed form where possible. The presolve splits the LP into independent
+ blocks and removes the noise symbols that are not constrained. In verified mode, the
+ complete LP is solved and the bounds are certified by its duals.
  
  @author Carna Radojicic
  
@@ -206,163 +778,86 @@ opt_sol solve_lp(const AAF& var1, vector<constraint<AAF> > constraints)
     
     opt_sol res;
     
-    unsigned l1, l2, ltemp;
-    
-    unsigned *id1, *id2;
-    
-    unsigned *pu1, *pu2, *idtemp;
-    
-    unsigned * fin;
-    
-    glp_prob *lp;
-    
-    int *ia, *ja;
-    
-    double *ar;
-    
-    AAF var2;
-    
-    //  Structure with parameters to set options.
-    glp_smcp param;
-    glp_init_smcp(&param);       // set options to defaults.
-    
-#ifdef AADD_DEBUG
-    param.msg_lev = GLP_MSG_ERR; // error and warning messages
-#else
-    param.msg_lev = GLP_MSG_OFF; // no output
-#endif
-    
-    
     if (var1.getlength() and constraints.size())
     {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
         
-        unsigned num_constraints=constraints.size();
-        
-        var2=constraints.back().con; // take last constraint
-        
-        l1=var1.getlength();
-        l2=var2.getlength();
-        
-        id1=var1.getIndexes();
-        id2=var2.getIndexes();
-        
-        pu1=id1;
-        pu2=id2;
+        const AAF& var2 = constraints.back().con; // take last constraint
         
+        unsigned l1 = var1.getlength();
+        unsigned l2 = var2.getlength();
+        const unsigned* id1 = var1.getIndexes();
+        const unsigned* id2 = var2.getIndexes();
         
-        idtemp=new unsigned[l1+l2];
-        
-        
-        fin = std::set_union(id1,id1+l1,id2,id2+l2,idtemp);
-        ltemp = fin-idtemp;
-        
-        ia=new int[(ltemp+1)*num_constraints+1];
-        ja=new int[(ltemp+1)*num_constraints+1];
-        ar=new double[(ltemp+1)*num_constraints+1];
-        
-        lp = glp_create_prob();
-        glp_set_prob_name(lp, "LP_problem");
-        
-        glp_add_rows(lp, num_constraints);
-        
-        for (unsigned j=0; j<num_constraints; j++)
+        vector<unsigned> idx(l1+l2);
+        unsigned len = std::set_union(id1, id1+l1, id2, id2+l2, idx.begin())-idx.begin();
+        if (lpOptions().verified)
         {
-            
-            string name="constraint"+to_string(j+1);
-            glp_set_row_name(lp,j+1,name.c_str());
-            
-            if (constraints[j].sign=='-')
-            {
-                glp_set_row_bnds(lp, j+1, GLP_UP, 0.0, 0.0); // constraint <= ths
-            }
-            else
+            // a bound is only rigorous on all symbols of the path; rows would lose terms else.
+            vector<unsigned> tmp;
+            idx.resize(len);
+            for (unsigned j=0; j+1 < constraints.size(); j++)
             {
-                glp_set_row_bnds(lp, j+1, GLP_LO, 0.0, 0.0); // constraint >= ths
+                const AAF& con = constraints[j].con;
+                tmp.resize(idx.size()+con.getlength());
+                tmp.resize(std::set_union(idx.begin(), idx.end(), con.getIndexes(),
+                                          con.getIndexes()+con.getlength(), tmp.begin())-tmp.begin());
+                idx.swap(tmp);
             }
-            
-            AAF con=constraints[j].con;
-            
-            l2=con.getlength();
-            id2=con.getIndexes();
-            
-            pu2=id2;
-            
-            for (unsigned k=0; k<ltemp+1; k++)
-            {
-                unsigned ind=j*(ltemp+1)+k+1;
-                
-                ia[ind]=j+1;
-                ja[ind]=k+1;
-                
-                if (k==0)
-                {
-                    if (constraints[j].sign=='-')
-                    {
-                        ar[ind]=con.getcenter()+con.offset_min;
-                    }
-                    else
-                    {
-                        ar[ind]=con.getcenter()+con.offset_max;
-                    }
-                }
-                else
-                {
-                    unsigned b = pu2-id2;
-                    
-                    if (b < l2 and id2[b] == idtemp[k-1])
-                    {
-                        ar[ind]=con[b+1];
-                        pu2++;
-                    }
-                    else
-                    {
-                        ar[ind]=0.0;
-                    }
-                }
-            }
-        } // end for
-        glp_add_cols(lp, ltemp+1);
-        glp_set_col_name(lp,1,"nom_value");
-        glp_set_col_bnds(lp, 1, GLP_FX, 1.0,1.0);
+            len = idx.size();
+        }
+        const bound_lp& lp = setup_lp(var1, constraints, &idx[0], len);
         
-        // glp_set_obj_coef(lp,1,var1.getcenter()+var1.offset_max); // to ensure upper bound
-        glp_set_obj_coef(lp,1,var1.getcenter());
+        static thread_local vector<bound_lp> blocks;
+        static thread_local bound_lp dropped;
+        double free_sum;
         
-        for (unsigned j=0; j<ltemp; ++j)
+        if (lpOptions().verified)
+        {
+            // the complete LP, so that one certificate covers it.
+            solve_bound_lp(lp, res);
+            lp_verification& v = lpVerification();
+            v.last_weak = !last_certified;
+            if (last_certified) v.certified++;
+            else v.weak++;
+        }
+        else if (lpOptions().presolve and presolve_lp(lp, blocks, dropped, free_sum))
         {
-            unsigned a = pu1-id1;
+            // the constant of the objective is given to the first block, as in the LP.
+            res.max = lp.offset_max+free_sum;
+            res.min = lp.offset_min-free_sum;
+            if (blocks.empty())
+            {
+                res.max += lp.c0;
+                res.min += lp.c0;
+            }
+            else blocks[0].c0 = lp.c0;
             
-            string name="e"+to_string(idtemp[j]);
-            glp_set_col_name(lp,j+2,name.c_str());
-            glp_set_col_bnds(lp, j+2, GLP_DB, -1.0, 1.0);
-            if (a<l1 and id1[a] == idtemp[j])
+            unsigned cols = 0;
+            lp_status status = LP_OPTIMAL;
+            for (unsigned b=0; b < blocks.size() and status == LP_OPTIMAL; b++)
             {
-                glp_set_obj_coef(lp,j+2,var1[a+1]);
-                pu1++;
+                opt_sol part;
+                status = solve_bound_lp(blocks[b], part);
+                res.max += part.max;
+                res.min += part.min;
+                cols += blocks[b].n;
             }
+            
+            // the rows without objective must hold as well.
+            if (status == LP_OPTIMAL and dropped.m > 0) status = feasible_lp(dropped);
+            
+            // without optimum, e.g. on an infeasible path, the complete LP decides as before.
+            if (status == LP_OPTIMAL) AADD_STAT_ADD(lp_presolved_cols, lp.n-cols);
+            else solve_bound_lp(lp, res);
         }
+        else solve_bound_lp(lp, res);
         
-        glp_load_matrix(lp,(ltemp+1)*num_constraints,ia,ja,ar);
-        
-        glp_set_obj_dir(lp, GLP_MAX);
-        
-        glp_simplex(lp, &param);
-        
-        res.max=glp_get_obj_val(lp)+var1.offset_max;
-        
-        glp_set_obj_coef(lp,1,var1.getcenter()); // to ensure lower bound
-        
-        glp_set_obj_dir(lp, GLP_MIN);
-        
-        glp_simplex(lp, &param);
-        
-        res.min=glp_get_obj_val(lp)+var1.offset_min;
-        
-        glp_delete_prob(lp);
-        
-        delete [] ia;
-        delete [] ja;
-        delete [] ar;
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now()-start;
+        lpCounters().calls++;
+        lpCounters().seconds += elapsed.count();
+        AADD_STAT_INC(lp_calls);
+        AADD_STAT_ADD(lp_nanoseconds, (unsigned long)(elapsed.count()*1e9));
     }
     else
     {
@@ -372,3 +867,187 @@ opt_sol solve_lp(const AAF& var1, vector<constraint<AAF> > constraints)
     return res;
 }
 
+
+/**
+ @brief Bounds of several AAF under the same constraints, on one LP.
+ @details The LP is set up once on the union of the noise symbols of the objectives and the
+ last constraint, and each objective is maximized and minimized on it; with warm start, each
+ solve starts from the basis of the previous one. An objective without optimum, e.g. on an
+ infeasible path, is bounded by solve_lp alone. In verified and compare mode, every
+ objective is bounded by solve_lp. Presolve and closed form are not used.
+ @return the bounds of objectives[i] in element i
+ */
+vector<opt_sol> solve_lp(const vector<const AAF*>& objectives, vector<constraint<AAF> > constraints)
+{
+    const lp_options& options = lpOptions();
+    unsigned k = objectives.size();
+    vector<opt_sol> res(k);
+
+    if (constraints.empty() or options.verified or options.solver == LP_SOLVER_COMPARE)
+    {
+        for (unsigned i=0; i < k; i++) res[i] = solve_lp(*objectives[i], constraints);
+        return res;
+    }
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    // columns of the LP
+    static thread_local vector<unsigned> idx, tmp;
+    const AAF& last = constraints.back().con;
+    const AAF* var1 = nullptr;
+    idx.assign(last.getIndexes(), last.getIndexes()+last.getlength());
+    for (unsigned i=0; i < k; i++)
+    {
+        const AAF& v = *objectives[i];
+        if (!v.getlength()) continue;
+        if (var1 == nullptr) var1 = &v;
+        tmp.resize(idx.size()+v.getlength());
+        tmp.resize(std::set_union(idx.begin(), idx.end(), v.getIndexes(), v.getIndexes()+v.getlength(),
+                                  tmp.begin())-tmp.begin());
+        idx.swap(tmp);
+    }
+
+    for (unsigned i=0; i < k; i++)
+    {
+        res[i].min = objectives[i]->getMin();
+        res[i].max = objectives[i]->getMax();
+    }
+    if (var1 == nullptr) return res;
+
+    bound_lp& lp = setup_lp(*var1, constraints, &idx[0], idx.size());
+    bool builtin = options.solver == LP_SOLVER_BUILTIN or
+                   (options.solver == LP_SOLVER_AUTO and lp.m <= options.max_rows
+                    and lp.n <= options.max_cols);
+    LPBackend& backend = options.backend != nullptr ? *options.backend :
+                         builtin ? (LPBackend&) builtinBackend() : (LPBackend&) glpkBackend();
+    if (&backend == &glpkBackend()) AADD_STAT_INC(glpk_calls);
+
+    backend.reset(lp.n);
+    for (unsigned j=0; j < lp.m; j++)
+        backend.addRow(&lp.A[j*lp.n], lp.r[j]);
+
+    // solve_lp of a single objective sets up the LP and backend anew; hence the objectives
+    // without optimum are bounded after the loop.
+    vector<unsigned> failed;
+    unsigned iterations = 0;
+    for (unsigned i=0; i < k; i++)
+    {
+        const AAF& v = *objectives[i];
+        if (!v.getlength()) continue;
+
+        setup_objective(lp, v, &idx[0], idx.size());
+        backend.setObjective(&lp.c[0], lp.c0);
+
+        double max, min;
+        lp_status smax = backend.maximize(max);
+        iterations += backend.iterations();
+        lp_status smin = backend.minimize(min);
+        iterations += backend.iterations();
+
+        if (smax == LP_OPTIMAL and smin == LP_OPTIMAL)
+        {
+            res[i].max = max+lp.offset_max;
+            res[i].min = min+lp.offset_min;
+        }
+        else failed.push_back(i);
+    }
+    AADD_STAT_ADD(simplex_iterations, iterations);
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now()-start;
+    lpCounters().calls++;
+    lpCounters().seconds += elapsed.count();
+    AADD_STAT_INC(lp_calls);
+    AADD_STAT_ADD(lp_nanoseconds, (unsigned long)(elapsed.count()*1e9));
+
+    for (unsigned f=0; f < failed.size(); f++)
+        res[failed[f]] = solve_lp(*objectives[failed[f]], constraints);
+    return res;
+}
+
+
+/**
+ @brief Adds the bits of x to the FNV-1a hash h.
+ */
+static inline void hash_add(unsigned long long& h, unsigned long long x)
+{
+    for (unsigned b=0; b < 8; b++, x >>= 8)
+    {
+        h ^= x & 0xff;
+        h *= 1099511628211ull;
+    }
+}
+
+static inline void data_add(vector<unsigned long long>& data, double d)
+{
+    unsigned long long x;
+    memcpy(&x, &d, sizeof(x));
+    data.push_back(x);
+}
+
+
+/**
+ @brief Key of the bounds of a leaf: the path conditions and the options of solve_lp.
+ @details data receives the conditions by their values in the order of the path, so that it
+ does not depend on the indexes that condMgr() gives them, and the options that change the
+ bounds. A cached bound is reused only if its data is the same; the returned hash of data
+ rejects other paths quickly. Reordering changes the order of the conditions on a path and
+ therefore the key; the cached bounds are then recomputed, not reused.
+ @return FNV-1a hash of data
+ */
+static unsigned long long bounds_key(const vector<constraint<AAF> >& constraints,
+                                     vector<unsigned long long>& data)
+{
+    const lp_options& options = lpOptions();
+    data.clear();
+    data.push_back((unsigned long long) options.solver);
+    data.push_back((unsigned long long) (options.closed_form + 2*options.presolve + 4*options.contract_boxes));
+    data.push_back((unsigned long long) options.max_rows << 32 | options.max_cols);
+    data.push_back((unsigned long long) (size_t) options.backend);
+
+    for (unsigned j=0; j < constraints.size(); j++)
+    {
+        const AAF& con = constraints[j].con;
+        const unsigned* id = con.getIndexes();
+        data.push_back((unsigned long long) constraints[j].sign << 32 | con.getlength());
+        data_add(data, con.getcenter());
+        data_add(data, con.offset_min);
+        data_add(data, con.offset_max);
+        for (unsigned k=0; k < con.getlength(); k++)
+        {
+            data.push_back((unsigned long long) id[k]);
+            data_add(data, con[k+1]);
+        }
+    }
+
+    unsigned long long h = 14695981039346656037ull;
+    for (size_t i=0; i < data.size(); i++) hash_add(h, data[i]);
+    return h;
+}
+
+
+/**
+ @brief Bounds of the value of a leaf under the constraints of its path.
+ @details With lpOptions().cache_bounds, the bounds are cached in the leaf and reused as long
+ as the path conditions and options are the same. The cache is deleted with the leaf.
+ */
+opt_sol solve_lp(const AADDNode& leaf, const vector<constraint<AAF> >& constraints)
+{
+    const lp_options& options = lpOptions();
+    if (!options.cache_bounds or options.verified) return solve_lp(leaf.getValue(), constraints);
+
+    opt_sol res;
+    static thread_local vector<unsigned long long> data;
+    unsigned long long key = bounds_key(constraints, data);
+    const leaf_bounds* cached = leaf.getBounds();
+    if (cached != nullptr and cached->key == key and cached->data == data)
+    {
+        AADD_STAT_INC(lp_cache_hits);
+        res.min = cached->min;
+        res.max = cached->max;
+        return res;
+    }
+
+    res = solve_lp(leaf.getValue(), constraints);
+    leaf.setBounds(key, data, res.min, res.max);
+    return res;
+}
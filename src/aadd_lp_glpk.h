@@ -42,6 +42,7 @@
 
 #include "aa.h"
 #include "glpk.h"
+#include "aadd_lp_backend.h"
 
 
 /**
@@ -65,6 +66,104 @@ struct opt_sol
 };
 
 opt_sol solve_lp(const AAF&, vector<constraint<AAF> >);
+vector<opt_sol> solve_lp(const vector<const AAF*>&, vector<constraint<AAF> >);
+
+
+/**
+ @brief Number of LPs solved by solve_lp and the time spent to solve them.
+ @details Bounds without constraints are not counted. The counters are per thread;
+ they can be reset by assigning zero.
+ */
+struct lp_counters
+{
+    unsigned long calls;
+    double seconds;
+};
+
+lp_counters& lpCounters();
+
+
+/**
+ @brief Solvers of solve_lp.
+ */
+enum lp_solver
+{
+    LP_SOLVER_AUTO,      // in-library solver for LP within max_rows and max_cols, otherwise GLPK
+    LP_SOLVER_BUILTIN,   // in-library solver
+    LP_SOLVER_GLPK,      // GLPK
+    LP_SOLVER_COMPARE    // both; the results are compared in lpComparison(), GLPK's are used
+};
+
+/**
+ @brief Options of solve_lp.
+ @details GLPK is also used if the in-library solver fails or finds the LP infeasible.
+ With closed_form, LP with one or two constraints are solved in closed form if possible,
+ except with LP_SOLVER_GLPK and LP_SOLVER_COMPARE. With presolve, noise symbols that are in
+ no constraint are removed, and the LP is split into independent blocks of constraints; blocks
+ that do not share noise symbols with the objective are dropped. If backend is set, it solves
+ all LP instead.
+ @details With verified, the bounds are not the floating-point optimum of the solver, but
+ rigorous bounds computed from its duals by weak duality with outward rounding. Closed form
+ and presolve are not used then, and the LP has the noise symbols of all path conditions. A certificate that is looser than the optimum by more than
+ verify_tolerance (relative), or missing, is reported in lpVerification().
+ @details With cache_bounds, the bounds of a leaf are kept in the node for the path conditions
+ and options they were computed for, and reused by GetBothBounds and the relational operators
+ until the node or its value is replaced. Not with verified. It is off by default, as each
+ cached leaf keeps a copy of its path conditions.
+ @details With contract_boxes, GetBothBounds and the relational operators contract a box of the
+ noise symbols by the conditions on each path (see NoiseBox). Paths whose box is empty are
+ pruned without LP; a comparison that the box of a leaf decides needs no LP.
+ @details The options are per thread; the solver is initialized from the environment variable
+ AADD_LP_SOLVER (auto, builtin, glpk, compare).
+ */
+struct lp_options
+{
+    lp_solver solver;
+    unsigned max_rows;
+    unsigned max_cols;
+    bool closed_form;
+    bool presolve;
+    bool verified;
+    double verify_tolerance;
+    bool cache_bounds;
+    bool contract_boxes;
+    LPBackend* backend;
+};
+
+lp_options& lpOptions();
+
+
+/**
+ @brief Comparison of the in-library solver with GLPK in mode LP_SOLVER_COMPARE.
+ @details A problem is counted as disagreement if one solver finds an optimum and the other
+ does not, or if the bounds differ by more than 1e-6 relative to their magnitude. The
+ comparison is per thread; it can be reset by assigning zero.
+ */
+struct lp_comparison
+{
+    unsigned long problems;
+    unsigned long disagreements;
+    double max_difference;
+    double seconds_glpk;
+    double seconds_builtin;
+};
+
+lp_comparison& lpComparison();
+
+
+/**
+ @brief Results of the verification of bounds with lpOptions().verified.
+ @details last_weak is set if the certificate of the last bounds computed by solve_lp was
+ missing or weak; a caller can then fall back to another method. The counters are per thread.
+ */
+struct lp_verification
+{
+    unsigned long certified;
+    unsigned long weak;
+    bool last_weak;
+};
+
+lp_verification& lpVerification();
 
 
 #endif
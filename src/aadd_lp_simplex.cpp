@@ -0,0 +1,423 @@
+/**
+
+ @file aadd_lp_simplex.cpp
+
+ @ingroup AADD
+
+ @brief In-library LP solver for the bound problems of AADD; implementation.
+
+ @details The problem is extended by a slack s_i >= 0 for each row, a'e + s_i = r_i, and
+ solved as min d'x with d = -c. The tableau of the slack basis is [A I]; the nonbasic e_j are
+ set to the bound that minimizes d_j e_j, which makes the basis dual feasible. Each iteration
+ takes the row whose basic variable violates its bounds most, and the entering column from the
+ ratio test of the bounded dual simplex. The tableau is kept explicitly, which is cheapest for
+ few rows.
+
+ @copyright@parblock
+ Copyright (c) 2017  Carna Radojicic, Christoph Grimm, Design of Cyber-Physical Systems
+ TU Kaiserslautern Postfach 3049 67663 Kaiserslautern radojicic@cs.uni-kl.de
+
+ This file is part of AADD package.
+
+ AADD is free software: you can redistribute it and/or modify it
+ under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ AADD is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public
+ License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with AADD package. If not, see <http://www.gnu.org/licenses/>.
+ @endparblock
+ */
+
+#include <math.h>
+#include <assert.h>
+#include <algorithm>
+
+#include "aadd_lp_simplex.h"
+
+// tolerances for violated bounds and for pivot elements.
+static const double PRIMAL_TOL = 1e-9;
+static const double PIVOT_TOL  = 1e-11;
+
+
+BoxSimplex::BoxSimplex()
+{
+    n = m = 0;
+    c0 = 0.0;
+    iters = 0;
+    valid = false;
+}
+
+
+/**
+ @brief Starts a new problem with n columns, no rows and objective 0.
+ */
+void BoxSimplex::reset(unsigned cols)
+{
+    n = cols;
+    m = 0;
+    A.clear();
+    r.clear();
+    c.assign(n, 0.0);
+    c0 = 0.0;
+    valid = false;
+}
+
+
+/**
+ @brief Adds the row a[0..n-1]'e <= rhs.
+ */
+void BoxSimplex::addRow(const double* a, double rhs)
+{
+    A.insert(A.end(), a, a+n);
+    r.push_back(rhs);
+    if (valid and warm_start) appendRow();
+    else valid = false;
+    m++;
+}
+
+
+/**
+ @brief Removes the last row.
+ */
+void BoxSimplex::removeRow()
+{
+    assert(m > 0);
+    m--;
+    A.resize(m*n);
+    r.resize(m);
+    valid = false;
+}
+
+
+/**
+ @brief Sets the objective to c[0..n-1]'e + constant.
+ */
+void BoxSimplex::setObjective(const double* obj, double constant)
+{
+    c.assign(obj, obj+n);
+    c0 = constant;
+}
+
+
+/**
+ @brief Computes max c'e.
+ @param value the optimum, if LP_OPTIMAL is returned.
+ */
+lp_status BoxSimplex::maximize(double& value)
+{
+    return solve(1.0, value);
+}
+
+
+/**
+ @brief Computes min c'e.
+ @details The duals are those of max -c'e.
+ @param value the optimum, if LP_OPTIMAL is returned.
+ */
+lp_status BoxSimplex::minimize(double& value)
+{
+    lp_status status = solve(-1.0, value);
+    value = -value;
+    return status;
+}
+
+
+/**
+ @brief Appends the new last row of A to the tableau of the current basis.
+ @details The slack of the row becomes basic; the other basic columns are eliminated from
+ the row. The reduced costs do not change, so the basis stays dual feasible.
+ */
+void BoxSimplex::appendRow()
+{
+    const unsigned w = n+m+1, nw = n+m+2;
+    vector<double> NT((m+1)*nw, 0.0);
+
+    for (unsigned i=0; i < m; i++)
+    {
+        for (unsigned j=0; j < n+m; j++) NT[i*nw+j] = T[i*w+j];
+        NT[i*nw+n+m+1] = T[i*w+n+m];
+    }
+
+    double* row = &NT[m*nw];
+    for (unsigned j=0; j < n; j++) row[j] = A[m*n+j];
+    row[n+m]   = 1.0;
+    row[n+m+1] = r[m];
+    for (unsigned i=0; i < m; i++)
+    {
+        const double f = row[basis[i]];
+        if (f == 0.0) continue;
+        const double* brow = &NT[i*nw];
+        for (unsigned j=0; j < nw; j++) row[j] -= f*brow[j];
+        row[basis[i]] = 0.0;
+    }
+
+    T.swap(NT);
+    basis.push_back(n+m);
+    state.push_back(0);
+    x.push_back(0.0);
+    z.push_back(0.0);
+}
+
+
+/**
+ @brief Sets up the slack basis, with the nonbasic e at the bound that minimizes d_j e_j.
+ */
+void BoxSimplex::coldStart(double sign)
+{
+    const unsigned w = n+m+1;
+
+    // slack basis: T = [A I r]
+    T.assign(m*w, 0.0);
+    for (unsigned i=0; i < m; i++)
+    {
+        for (unsigned j=0; j < n; j++) T[i*w+j] = A[i*n+j];
+        T[i*w+n+i] = 1.0;
+        T[i*w+n+m] = r[i];
+    }
+
+    // reduced costs of min d'x, d = -sign*c
+    z.assign(n+m, 0.0);
+    x.assign(n+m, 0.0);
+    state.assign(n+m, 0);
+    basis.resize(m);
+    for (unsigned j=0; j < n; j++)
+    {
+        z[j] = -sign*c[j];
+        state[j] = z[j] < 0.0 ? 1 : -1;
+        x[j] = state[j];
+    }
+    for (unsigned i=0; i < m; i++) basis[i] = n+i;
+}
+
+
+/**
+ @brief Computes the reduced costs of the current basis for the objective sign*c.
+ @details Nonbasic e are moved to the bound that makes them dual feasible.
+ @return false if a nonbasic slack is not dual feasible; then the basis cannot be used.
+ */
+bool BoxSimplex::warmStart(double sign)
+{
+    const unsigned w = n+m+1;
+
+    for (unsigned j=0; j < n+m; j++)
+        z[j] = j < n ? -sign*c[j] : 0.0;
+    for (unsigned i=0; i < m; i++)
+    {
+        const unsigned k = basis[i];
+        const double dk = k < n ? -sign*c[k] : 0.0;
+        if (dk == 0.0) continue;
+        const double* row = &T[i*w];
+        for (unsigned j=0; j < n+m; j++) z[j] -= dk*row[j];
+    }
+
+    for (unsigned j=0; j < n+m; j++)
+    {
+        if (state[j] == 0) { z[j] = 0.0; continue; }
+        if (j >= n)
+        {
+            if (z[j] < -1e-12) return false;
+        }
+        else if (z[j] != 0.0)
+        {
+            state[j] = z[j] < 0.0 ? 1 : -1;
+            x[j] = state[j];
+        }
+    }
+    return true;
+}
+
+
+/**
+ @brief Computes the values of the basic variables from the last column of the tableau
+ and the values of the nonbasic variables.
+ */
+void BoxSimplex::computeBasics()
+{
+    const unsigned w = n+m+1;
+
+    for (unsigned i=0; i < m; i++)
+    {
+        const double* row = &T[i*w];
+        double v = row[n+m];
+        for (unsigned j=0; j < n+m; j++)
+            if (state[j] != 0 and x[j] != 0.0) v -= row[j]*x[j];
+        x[basis[i]] = v;
+    }
+}
+
+
+/**
+ @brief Exchanges the basic variable of row p with column q.
+ */
+void BoxSimplex::pivot(unsigned p, unsigned q)
+{
+    const unsigned w = n+m+1;
+    double* prow = &T[p*w];
+    const double inv = 1.0/prow[q];
+
+    for (unsigned j=0; j < w; j++) prow[j] *= inv;
+    prow[q] = 1.0;
+
+    for (unsigned i=0; i < m; i++)
+    {
+        if (i == p) continue;
+        double* row = &T[i*w];
+        const double f = row[q];
+        if (f == 0.0) continue;
+        for (unsigned j=0; j < w; j++) row[j] -= f*prow[j];
+        row[q] = 0.0;
+    }
+    basis[p] = q;
+}
+
+
+/**
+ @brief Dual simplex for max sign*c'e.
+ */
+lp_status BoxSimplex::solve(double sign, double& value)
+{
+    const unsigned w = n+m+1;
+    const unsigned max_iters = 10*(n+m)+50;
+
+    if (not (warm_start and valid and warmStart(sign)))
+        coldStart(sign);
+
+    lp_status status = LP_FAILED;
+    for (iters=0; iters <= max_iters; iters++)
+    {
+        computeBasics();
+
+        // leaving row: maximal violation of the bounds of the basic variable.
+        unsigned p = m;
+        double viol = PRIMAL_TOL;
+        bool to_lower = true;
+        for (unsigned i=0; i < m; i++)
+        {
+            const unsigned k = basis[i];
+            const double lo = k < n ? -1.0 : 0.0;
+            if (lo-x[k] > viol)                 { p = i; viol = lo-x[k]; to_lower = true; }
+            else if (k < n and x[k]-1.0 > viol) { p = i; viol = x[k]-1.0; to_lower = false; }
+        }
+        if (p == m) { status = LP_OPTIMAL; break; }
+        if (iters == max_iters) break;
+
+        // entering column: ratio test that keeps the reduced costs dual feasible.
+        const double* prow = &T[p*w];
+        unsigned q = n+m;
+        double ratio = 0.0, piv = 0.0;
+        for (unsigned j=0; j < n+m; j++)
+        {
+            if (state[j] == 0) continue;
+            const double a = prow[j];
+            if (fabs(a) < PIVOT_TOL) continue;
+            // x_Bp increases if a nonbasic variable at lower with a < 0 increases
+            // or one at upper with a > 0 decreases.
+            const bool eligible = to_lower ? (state[j] < 0 ? a < 0 : a > 0)
+                                           : (state[j] < 0 ? a > 0 : a < 0);
+            if (not eligible) continue;
+            const double rt = fabs(z[j])/fabs(a);
+            if (q == n+m or rt < ratio or (rt == ratio and fabs(a) > fabs(piv)))
+            {
+                q = j; ratio = rt; piv = a;
+            }
+        }
+        if (q == n+m) { status = LP_INFEASIBLE; break; }
+
+        const unsigned leaving = basis[p];
+        const double theta = z[q]/piv;
+        for (unsigned j=0; j < n+m; j++)
+            if (state[j] != 0 or j == leaving) z[j] -= theta*prow[j];
+        z[q] = 0.0;
+
+        pivot(p, q);
+        state[q] = 0;
+        state[leaving] = to_lower ? -1 : 1;
+        x[leaving] = to_lower ? (leaving < n ? -1.0 : 0.0) : 1.0;
+    }
+    valid = status != LP_FAILED;
+
+    // values and duals of max sign*c'e
+    value = sign*c0;
+    for (unsigned j=0; j < n; j++) value += sign*c[j]*x[j];
+    y.assign(m, 0.0);
+    for (unsigned i=0; i < m; i++)
+        if (state[n+i] != 0) y[i] = z[n+i];
+
+    return status;
+}
+
+
+/**
+ @brief Continuous knapsack: max c'e, a'e <= b, e in [-1,1]^n.
+ @return false if a'e <= b cannot hold in the box.
+ */
+static bool knapsack(unsigned n, const double* a, double b, const double* c, double* e)
+{
+    static thread_local vector<pair<double, unsigned> > moves;
+    moves.clear();
+
+    // corner of max c'e; symbols without objective take the side that helps the row.
+    double s = 0.0;
+    for (unsigned j=0; j < n; j++)
+    {
+        if (c[j] > 0.0)      e[j] = 1.0;
+        else if (c[j] < 0.0) e[j] = -1.0;
+        else                 e[j] = a[j] > 0.0 ? -1.0 : 1.0;
+        s += a[j]*e[j];
+
+        // moving e_j to the other bound reduces a'e by 2|a_j| at a loss of 2|c_j|.
+        if (c[j] != 0.0 and a[j]*e[j] > 0.0)
+            moves.push_back(make_pair(fabs(c[j])/fabs(a[j]), j));
+    }
+    if (s <= b) return true;
+
+    sort(moves.begin(), moves.end());
+    for (unsigned k=0; k < moves.size() and s > b; k++)
+    {
+        const unsigned j = moves[k].second;
+        const double t = min(2.0, (s-b)/fabs(a[j]));  // distance e_j is moved
+        s -= t*fabs(a[j]);
+        e[j] -= t*(e[j] > 0.0 ? 1.0 : -1.0);
+    }
+    return s <= b*(1.0+1e-12)+1e-12;
+}
+
+
+bool closedFormMax(unsigned n, unsigned m, const double* A, const double* r, const double* c,
+                   double* e, double& value)
+{
+    const double tol = 1e-9;
+    bool found = false;
+
+    if (m > 2) return false;
+    if (m == 0)
+    {
+        for (unsigned j=0; j < n; j++) e[j] = c[j] < 0.0 ? -1.0 : 1.0;
+        found = true;
+    }
+    for (unsigned k=0; k < m and not found; k++)
+    {
+        if (not knapsack(n, &A[k*n], r[k], c, e)) return false;
+
+        // the solution of one row is optimal if it satisfies the other row.
+        found = true;
+        for (unsigned i=0; i < m; i++)
+        {
+            if (i == k) continue;
+            double s = 0.0;
+            for (unsigned j=0; j < n; j++) s += A[i*n+j]*e[j];
+            if (s > r[i]+tol*(1.0+fabs(r[i]))) found = false;
+        }
+    }
+    if (not found) return false;
+
+    value = 0.0;
+    for (unsigned j=0; j < n; j++) value += c[j]*e[j];
+    return true;
+}
@@ -0,0 +1,118 @@
+/**
+
+ @file aadd_lp_simplex.h
+
+ @ingroup AADD
+
+ @brief In-library LP solver for the bound problems of AADD.
+
+ @details All LP solved for AADD have the same structure: the variables are noise symbols
+ boxed in [-1,1], and there are a few constraints from the path conditions. BoxSimplex is a
+ dense, bounded-variable dual simplex for such problems
+ @verbatim
+   max c'e   s.t.  A e <= r,  -1 <= e <= 1
+ @endverbatim
+ with few rows and tens to hundreds of columns. It starts from the optimum over the box,
+ which is dual feasible, and only pivots to repair violated rows. Its memory is kept between
+ problems; setting up a problem allocates nothing after the first ones.
+
+ @copyright@parblock
+ Copyright (c) 2017  Carna Radojicic, Christoph Grimm, Design of Cyber-Physical Systems
+ TU Kaiserslautern Postfach 3049 67663 Kaiserslautern radojicic@cs.uni-kl.de
+
+ This file is part of AADD package.
+
+ AADD is free software: you can redistribute it and/or modify it
+ under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ AADD is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public
+ License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with AADD package. If not, see <http://www.gnu.org/licenses/>.
+ @endparblock
+ */
+
+#ifndef aadd_lp_simplex_h
+#define aadd_lp_simplex_h
+
+#include <vector>
+
+#include "aadd_lp_backend.h"
+
+using namespace std;
+
+
+/**
+ @brief Dense bounded-variable dual simplex for max c'e + c0, A e <= r, e in [-1,1]^n.
+ @details With warm start, an optimal basis is kept: rows added afterwards are appended to
+ the tableau and the solve continues from it; after a change of the objective it is reused if
+ the reduced costs of the nonbasic slacks permit. Removing a row restarts from the slack basis.
+ */
+class BoxSimplex: public LPBackend
+{
+public:
+    BoxSimplex();
+
+    const char* name() const                     { return "builtin"; };
+
+    void reset(unsigned n);                      // new problem with n columns and no rows.
+    void addRow(const double* a, double rhs);    // adds a[0..n-1]'e <= rhs.
+    void removeRow();                            // removes the last row.
+    void setObjective(const double* c, double c0=0.0);  // sets c[0..n-1] and the constant c0.
+
+    lp_status maximize(double& value);
+    lp_status minimize(double& value);
+
+    unsigned numRows() const                     { return m; };
+    unsigned numCols() const                     { return n; };
+    unsigned iterations() const                  { return iters; };  // pivots of last solve.
+    const vector<double>& solution() const       { return x; };      // e and slacks of last solve.
+    const vector<double>& duals() const          { return y; };      // row multipliers of last solve, >= 0.
+    bool getDuals(vector<double>& duals) const   { duals = y; return valid; };
+
+protected:
+    unsigned n, m;                 // columns and rows
+    vector<double> A;              // rows of the constraints, m x n
+    vector<double> r;              // right hand sides
+    vector<double> c;              // objective
+    double c0;                     // constant of the objective
+
+    // working data of the dual simplex on columns e[0..n-1] and slacks s[0..m-1].
+    vector<double> T;              // tableau B^-1 [A I r], m x (n+m+1)
+    vector<double> z;              // reduced costs of min -c'e
+    vector<double> x;              // values of the columns
+    vector<double> y;              // dual values of the rows
+    vector<int>    basis;          // basic column of each row
+    vector<signed char> state;     // -1 at lower bound, +1 at upper bound, 0 basic
+    bool     valid;                // T, basis and state are a basis of the rows
+    unsigned iters;
+
+    lp_status solve(double sign, double& value);
+    void coldStart(double sign);
+    bool warmStart(double sign);
+    void appendRow();
+    void computeBasics();
+    void pivot(unsigned p, unsigned q);
+};
+
+
+/**
+ @brief Closed-form max c'e, A e <= r, e in [-1,1]^n for m <= 2 rows.
+ @details Without rows, the maximum is at the corner sign(c). With one row, the LP is a
+ continuous knapsack: starting from that corner, the symbols with the smallest loss of
+ objective per reduction of the row are moved until the row holds. With two rows, the
+ solution with one of the rows is taken if it satisfies the other; otherwise there is no
+ closed form.
+ @param e receives the solution, n values.
+ @return false if there is no closed form or the rows cannot be satisfied; then the LP has
+ to be solved.
+ */
+bool closedFormMax(unsigned n, unsigned m, const double* A, const double* r, const double* c,
+                   double* e, double& value);
+
+#endif /* aadd_lp_simplex_h */
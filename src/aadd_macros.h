@@ -4,10 +4,17 @@
    Macros that replace conditional and iteration statements. 
  */ 
 
-#define ifS(cond)       { bCond().thenBlock(cond);
+#define ifS(cond)       { bCond().thenBlock((profiler().enterCond(__FILE__, __LINE__, 'i'), (cond)));
 #define elseS             bCond().elseBlock(__LINE__, __FILE__);
 #define endS              bCond().endBlock(__LINE__, __FILE__);}
-#define whileS(cond)    while (cond!=false) \
+#define whileS(cond)    for (loopScope loop_scope_(__FILE__, __LINE__); profiler().loopTest(loop_scope_.test( \
+                            bool((profiler().enterCond(__FILE__, __LINE__, 'w'), (cond)) != false))); ) \
+                        { bCond().whileBlock(cond);
+
+// whileS with the AADD that the loop changes, for loopOptions().analysis; see aadd_loop.h.
+#define whileStateS(cond, ...) \
+                        for (loopScope loop_scope_(__FILE__, __LINE__, {__VA_ARGS__}); profiler().loopTest(loop_scope_.test( \
+                            bool((profiler().enterCond(__FILE__, __LINE__, 'w'), (cond)) != false))); ) \
                         { bCond().whileBlock(cond);
 
 
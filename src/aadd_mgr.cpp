@@ -35,48 +35,109 @@
  @endparblock
  */
 
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+
 #include "aadd.h"
 
 
+/**
+ @brief Creates the manager on first use.
+ @details The banner and the CPU time are only printed if the environment variable
+ AADD_VERBOSE is set (and not 0), or if aaddInit(true) is called.
+ */
 blockMgrC::blockMgrC()
 {
-    cout << "==============================================" << endl;
-    cout << "  AADD lib -- Symbolic execution is enabled."   << endl;
-    cout << "     AADD library (c) TU Kaiserslautern,"       << endl;
-    cout << "          C. Zivkovic, C. Grimm."              << endl;
-    cout << "============================================="  << endl
-    << endl;
-    startcputime = clock();
+    // the profiler is used by the destructor, hence it must be created before.
+    profiler();
+
+    const char* env = getenv("AADD_VERBOSE");
+    in_if = false;
+    banner_shown = false;
+    start(env != nullptr and strcmp(env, "0") != 0);
 }
 
 
 blockMgrC::~blockMgrC()
 {
-    double cpu_duration = (clock() - startcputime) / (double)CLOCKS_PER_SEC;
-    cout << endl;
-    cout << "AADD lib finished." << endl;
-    cout << "CPU time used: " << cpu_duration << " sec."<< endl;
-    // condMgr().printConditions();
+    finish();
 }
 
 
-void blockMgrC::printError(string error_message, const int line, string file_name) const
+void blockMgrC::start(bool v)
 {
-    if (line>0)
+    verbose  = v;
+    finished = false;
+    conditions.clear();
+    in_if = false;
+    profiler().clearBlocks();
+    startcputime = clock();
+
+    if (verbose and !banner_shown)
     {
-        cerr << error_message << " in line " << line << " in file " << file_name << endl;
+        cout << "==============================================" << endl;
+        cout << "  AADD lib -- Symbolic execution is enabled."   << endl;
+        cout << "     AADD library (c) TU Kaiserslautern,"       << endl;
+        cout << "          C. Zivkovic, C. Grimm."              << endl;
+        cout << "============================================="  << endl
+        << endl;
+        banner_shown = true;
     }
-    else
+}
+
+
+void blockMgrC::finish()
+{
+    if (finished) return;
+    finished = true;
+    conditions.clear();
+    in_if = false;
+
+    if (verbose)
     {
-        cerr << error_message << endl;
+        double cpu_duration = (clock() - startcputime) / (double)CLOCKS_PER_SEC;
+        cout << endl;
+        cout << "AADD lib finished." << endl;
+        cout << "CPU time used: " << cpu_duration << " sec."<< endl;
     }
     
-    exit(1);
+    if (profiler().isEnabled())
+        profiler().report(cout, profiler().reportSize());
+    
+#ifdef AADD_STATISTICS
+    const char* stats_file = getenv("AADD_STATS_JSON");
+    if (stats_file != nullptr)
+    {
+        ofstream s(stats_file);
+        aaddStats().printJSON(s);
+    }
+#endif
+    // condMgr().printConditions();
+}
+
+
+/**
+ @brief Creates an exception; the location is appended to the message if it is known.
+ */
+AADD_Exception::AADD_Exception(const int code, const std::string& msg, unsigned l, const std::string& f):
+    AAF_Exception(code, msg.c_str()), line(l), file(f)
+{
+    if (line > 0)
+        message += " in line " + to_string(line) + " in file " + file;
+}
+
+
+void blockMgrC::printError(string error_message, const int line, string file_name) const
+{
+    throw AADD_Exception(AADD_SYNTAX_EXCEPTION, error_message, line, file_name);
 }
 
 
 void blockMgrC::thenBlock(const BDD& c)
 {
+    condMgr().reorderIfNeeded();
+    profiler().beginBlock(c);
     in_if = true;
     conditions.push_back(new BDD(c) );
 }
@@ -101,6 +162,7 @@ void blockMgrC::endBlock(const unsigned line, const string& file_name)
 {
     if (!conditions.empty())
     {
+        profiler().endBlock();
         conditions.pop_back();
         
         // end of conditional statement
@@ -114,6 +176,8 @@ void blockMgrC::endBlock(const unsigned line, const string& file_name)
 
 void blockMgrC::whileBlock(const BDD& c)
 {
+    condMgr().reorderIfNeeded();
+    profiler().beginBlock(c);
     // to have only one condition on stack
     if (!conditions.empty())
     {
@@ -124,25 +188,53 @@ void blockMgrC::whileBlock(const BDD& c)
     conditions.push_back(new BDD(c) );
 }
 
-//@short static instance of blockMgrC - there is only this one instance.
-static blockMgrC block_cond_manager;
-
+//@short instance of blockMgrC - there is only this one instance; created on first use.
 blockMgrC& bCond()
 {
+    static blockMgrC block_cond_manager;
     return block_cond_manager;
 }
 
-//@short static instance of condMgr - there is only this one instance.
-static condMgrC condition_manager;
+//@short instance of condMgr - there is only this one instance; created on first use.
 condMgrC& condMgr()
 {
+    static condMgrC condition_manager;
     return condition_manager;
 };
 
+
+/**
+ @brief Initializes the library; optional, as the managers are created on first use.
+ @details If verbose is true, the banner and at the end the CPU time are printed.
+ The CPU time is measured from the call. The stack of block conditions is cleared,
+ e.g. after an AADD_Exception in a conditional statement.
+ */
+void aaddInit(bool verbose)
+{
+    condMgr();
+    bCond().start(verbose);
+}
+
+/**
+ @brief Shuts down the library; optional, it is done at program end otherwise.
+ @details Prints the CPU time if verbose, the profile if enabled, and writes the statistics.
+ Deletes the path conditions; decision diagrams that exist must not be used afterwards,
+ except for deleting them. aaddInit starts the library again.
+ */
+void aaddShutdown()
+{
+    bCond().finish();
+    condMgr().clear();
+    condMgr().dropDiagrams();
+}
+
 unsigned long condMgrC::addCond(const AAF& c)
 {
+    AADD_STAT_INC(conds_added);
     AAF *condition = new AAF(c);
     path_conditions.push_back(condition);
+    cond_id.push_back(index_of.size());
+    index_of.push_back(last_index);
     last_index++;
     return last_index-1;
 };
@@ -154,12 +246,250 @@ AAF& condMgrC::getCond(unsigned long index) const
     return *c;
 };
 
+void condMgrC::clear()
+{
+    for (unsigned long i=0; i < path_conditions.size(); i++)
+        delete path_conditions[i];
+    path_conditions.clear();
+    cond_id.clear();
+    index_of.clear();
+    last_index=0;
+}
+
+// exchanges the conditions, their ids and indexes with the ones of other, e.g. to save them
+// while conditions are installed tentatively. The options of reordering are kept.
+void condMgrC::swapConditions(condMgrC& other)
+{
+    path_conditions.swap(other.path_conditions);
+    cond_id.swap(other.cond_id);
+    index_of.swap(other.index_of);
+    std::swap(last_index, other.last_index);
+}
+
+// removes all live diagrams from the list that reordering updates. Called after the conditions
+// are replaced for good: the diagrams refer to the old conditions, and their indexes may not
+// exist anymore. Diagrams created afterwards are reordered again.
+void condMgrC::dropDiagrams()
+{
+    DDBase<AAF>::unlinkAll();
+    DDBase<bool>::unlinkAll();
+}
+
 condMgrC::condMgrC()
 {
     last_index=0;
+    auto_reorder=false;
+    reorder_threshold=100000;
+
+    const char* env = getenv("AADD_REORDER");
+    if (env != nullptr and atol(env) > 0) setAutoReorder(true, atol(env));
 };
 
 
+/*
+ Reordering of the conditions. As the AADD and BDD are trees, two adjacent levels are
+ swapped by moving the nodes of the lower level above those of the upper one, in place.
+ */
+
+// copies a subtree; shared leaves of BDD are not copied.
+template<class ValT>
+static DDNode<ValT>* copyTree(DDNode<ValT>* f)
+{
+    return f->isShared() ? f : new DDNode<ValT>(*f);
+}
+
+// deletes a single node, but not its children.
+template<class ValT>
+static void freeNode(DDNode<ValT>* f)
+{
+    if (f->isShared()) return;
+    f->setT(nullptr);
+    f->setF(nullptr);
+    delete f;
+}
+
+// leaves are merged only if their values are exactly the same, including the offsets.
+static bool sameValue(const AAF& a, const AAF& b) { return a.isIdentical(b); }
+static bool sameValue(bool a, bool b) { return a == b; }
+
+// true if the trees f and g are equal.
+template<class ValT>
+static bool sameTree(const DDNode<ValT>* f, const DDNode<ValT>* g)
+{
+    if (f == g) return true;
+    if (f->getIndex() != g->getIndex()) return false;
+    if (f->isLeaf()) return sameValue(f->getValue(), g->getValue());
+    return sameTree(f->getT(), g->getT()) and sameTree(f->getF(), g->getF());
+}
+
+// (re-)uses node as node with index and children T, F. Reduces equal subtrees, so that
+// swapping back restores the size of the trees.
+template<class ValT>
+static DDNode<ValT>* makeNode(DDNode<ValT>* node, unsigned long index, DDNode<ValT>* T, DDNode<ValT>* F)
+{
+    if (sameTree(T, F))
+    {
+        if (node != nullptr) freeNode(node);
+        if (F->isNotShared()) delete F;
+        return T;
+    }
+    if (node == nullptr) return new DDNode<ValT>(index, T, F);
+
+    node->setIndex(index);
+    node->setT(T);
+    node->setF(F);
+    return node;
+}
+
+// swaps levels k and k+1 in the tree f; returns the new root. Levels above k+1, including
+// indexes without condition, are not changed.
+template<class ValT>
+static DDNode<ValT>* swapTree(DDNode<ValT>* f, unsigned long k)
+{
+    unsigned long index = f->getIndex();
+
+    if (f->isLeaf() or index > k+1) return f;
+    if (index == k+1)
+    {
+        f->setIndex(k);
+        return f;
+    }
+    if (index < k)
+    {
+        f->setT(swapTree(f->getT(), k));
+        f->setF(swapTree(f->getF(), k));
+        return f;
+    }
+
+    // f is at level k: f ? (g ? T1 : T0) : (g ? F1 : F0) becomes g ? (f ? T1 : F1) : (f ? T0 : F0).
+    DDNode<ValT> *T = f->getT(), *F = f->getF();
+    bool tg = (T->getIndex() == k+1), fg = (F->getIndex() == k+1);
+    if (!tg and !fg)
+    {
+        f->setIndex(k+1);
+        return f;
+    }
+
+    DDNode<ValT> *T1, *T0, *F1, *F0;
+    if (tg) { T1 = T->getT(); T0 = T->getF(); }
+    else    { T1 = T; T0 = copyTree(T); }
+    if (fg) { F1 = F->getT(); F0 = F->getF(); }
+    else    { F1 = F; F0 = copyTree(F); }
+
+    DDNode<ValT>* hi = makeNode(tg ? T : nullptr, k+1, T1, F1);
+    DDNode<ValT>* lo = makeNode(fg ? F : nullptr, k+1, T0, F0);
+    return makeNode(f, k, hi, lo);
+}
+
+
+/**
+ @brief Exchanges the conditions at index and index+1.
+ @details All live AADD and BDD, including the stack of block conditions, are updated,
+ except the ones that were dropped when the conditions were replaced (dropDiagrams).
+ Frozen diagrams refer to the indexes at the time of freezing.
+ */
+void condMgrC::swapLevels(unsigned long index)
+{
+    assert(index+1 < last_index);
+
+    for (DDBase<AAF>* d = DDBase<AAF>::registry; d != nullptr; d = d->reg_next)
+        if (d->root != nullptr) d->root = swapTree(d->root, index);
+    for (DDBase<bool>* d = DDBase<bool>::registry; d != nullptr; d = d->reg_next)
+        if (d->root != nullptr) d->root = swapTree(d->root, index);
+
+    swap(path_conditions[index], path_conditions[index+1]);
+    swap(cond_id[index], cond_id[index+1]);
+    index_of[cond_id[index]] = index;
+    index_of[cond_id[index+1]] = index+1;
+}
+
+
+unsigned long condMgrC::liveNodes()
+{
+    return DDNode<AAF>::live + DDNode<bool>::live;
+}
+
+
+// counts the internal nodes of f per level; levels without condition are not counted.
+template<class ValT>
+static void countLevels(const DDNode<ValT>* f, vector<unsigned long>& count)
+{
+    if (f->isLeaf() or f->getIndex() >= count.size()) return;
+    count[f->getIndex()]++;
+    countLevels(f->getT(), count);
+    countLevels(f->getF(), count);
+}
+
+
+/**
+ @brief Reorders the conditions by sifting.
+ @details The max_conds conditions with the most nodes are sifted in order of their number of nodes.
+ Each is moved through all levels by swapping adjacent levels and placed where the number of nodes
+ of all diagrams is smallest. A direction is given up if the number of nodes grows above
+ max_growth times the best number found so far. At most max_swaps swaps are done in total.
+ Must not be called while an operation on diagrams is in progress.
+ */
+void condMgrC::reorder(double max_growth, unsigned max_conds, unsigned long max_swaps)
+{
+    unsigned long n = last_index;
+    if (n < 2) return;
+
+    vector<unsigned long> count(n, 0);
+    for (DDBase<AAF>* d = DDBase<AAF>::registry; d != nullptr; d = d->reg_next)
+        if (d->root != nullptr) countLevels(d->root, count);
+    for (DDBase<bool>* d = DDBase<bool>::registry; d != nullptr; d = d->reg_next)
+        if (d->root != nullptr) countLevels(d->root, count);
+
+    vector<pair<unsigned long, unsigned long> > order;  // (nodes, id)
+    for (unsigned long i=0; i < n; i++)
+        if (count[i] > 0) order.push_back(make_pair(count[i], cond_id[i]));
+    sort(order.rbegin(), order.rend());
+    if (order.size() > max_conds) order.resize(max_conds);
+
+    unsigned long swaps = 0;
+    for (unsigned long i=0; i < order.size(); i++)
+    {
+        unsigned long pos  = index_of[order[i].second];
+        unsigned long best = liveNodes(), best_pos = pos;
+
+        while (pos+1 < n and swaps < max_swaps)
+        {
+            swapLevels(pos++); swaps++;
+            if (liveNodes() < best) { best = liveNodes(); best_pos = pos; }
+            if (liveNodes() > max_growth*best) break;
+        }
+        while (pos > 0 and swaps < max_swaps)
+        {
+            swapLevels(--pos); swaps++;
+            if (liveNodes() < best) { best = liveNodes(); best_pos = pos; }
+            if (liveNodes() > max_growth*best) break;
+        }
+        while (pos < best_pos) swapLevels(pos++);
+        while (pos > best_pos) swapLevels(--pos);
+    }
+}
+
+
+/**
+ @brief Enables or disables reordering when the number of nodes exceeds threshold.
+ @details After each reordering, the threshold is raised to twice the remaining nodes.
+ Can also be enabled by the environment variable AADD_REORDER=threshold.
+ */
+void condMgrC::setAutoReorder(bool on, unsigned long threshold)
+{
+    auto_reorder = on;
+    reorder_threshold = threshold;
+}
+
+void condMgrC::reorderIfNeeded()
+{
+    if (!auto_reorder or liveNodes() < reorder_threshold) return;
+
+    reorder();
+    if (2*liveNodes() > reorder_threshold) reorder_threshold = 2*liveNodes();
+}
+
+
 void condMgrC::printConditions()
 {
     cout << "Conditions: " << last_index << endl;
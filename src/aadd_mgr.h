@@ -44,13 +44,36 @@
 #define aadd_if_h
 
 #include <vector>
+#include <string>
 #include <time.h>
 
+#include "aa_exceptions.h"
+
 using namespace std;
 
 class AAF;
 class BDD;
 class AADD;
+class DDCheckpoint;
+
+
+/**
+ @brief Exception thrown by the AADD library on errors in a model.
+ @details Errors are e.g. wrong nesting of ifS/elseS/endS (AADD_SYNTAX_EXCEPTION), operations that
+ are not defined on ranges (AADD_RANGE_EXCEPTION), a division by zero (AAF_DIVZERO_EXCEPTION), or a
+ loop that does not reach a fixed point with loop analysis (AADD_LOOP_EXCEPTION).
+ After an error in a conditional or iteration statement, the stack of block conditions is not
+ valid; call aaddInit() before the next model is executed.
+ */
+class AADD_Exception: public AAF_Exception
+{
+public:
+    unsigned line;            // location in the model, if known; otherwise 0.
+    std::string file;
+
+    AADD_Exception(const int code, const std::string& msg, unsigned line=0, const std::string& file="");
+    ~AADD_Exception() throw() {};
+};
 
 /**
  @brief The class condMgr manages the path conditions in a program run.
@@ -64,13 +87,33 @@ class condMgrC
 private:
     vector<AAF*> path_conditions; // Vector of path conditions. Index is the index of AADD/BDD.
     unsigned long last_index;
+    vector<unsigned long> cond_id;  // id of the condition at each index.
+    vector<unsigned long> index_of; // index of each id.
+    bool auto_reorder;
+    unsigned long reorder_threshold;
     
 public:
     unsigned long addCond(const AAF&c);        // returns index of new condition
     AAF& getCond(unsigned long index) const;
+    unsigned long size() const                 { return last_index; };
+    void clear();                              // deletes all conditions.
+    void swapConditions(condMgrC& other);      // exchanges the conditions and their ids.
+    void dropDiagrams();                       // live diagrams are no longer reordered.
     void printConditions();
     
+    // The index of a condition is its level in all diagrams; reordering changes the index,
+    // but not the id. Ids are given in order of creation.
+    unsigned long getId(unsigned long index) const  { return cond_id[index]; };
+    unsigned long getIndex(unsigned long id) const  { return index_of[id]; };
+    void swapLevels(unsigned long index);      // exchanges the conditions at index and index+1.
+    void reorder(double max_growth=1.2,        // sifting of the conditions with most nodes.
+                 unsigned max_conds=20, unsigned long max_swaps=2000);
+    void setAutoReorder(bool on, unsigned long threshold=100000);
+    void reorderIfNeeded();                    // called between statements.
+    static unsigned long liveNodes();          // nodes of all AADD and BDD.
+    
     condMgrC();
+    
 }; // Not yet fully in use.
 
 condMgrC& condMgr();
@@ -88,11 +131,17 @@ private:
     vector<BDD* > conditions;                  //@short holds a stack of block conditions.
     bool in_if;                                //@short true if in then-part of if statement.
     clock_t startcputime;
+    bool verbose;                              //@short true if banner and CPU time are printed.
+    bool banner_shown;
+    bool finished;                             //@short true after finish, until next start.
     
 public:
     blockMgrC();
     ~blockMgrC();
     
+    void start(bool verbose);                  //@short (re-)starts measuring CPU time; prints banner if verbose.
+    void finish();                             //@short prints CPU time, profile and statistics; clears stack.
+    
     void thenBlock(const BDD& c);              //@short starts a conditional block, e.g. in if(c) ...
     void elseBlock(unsigned line, const string& filename); //@short adds else part.
     void endBlock(unsigned line, const string& filename); //@short pops a block condition.
@@ -102,11 +151,18 @@ public:
     inline bool inCond()                       { return !conditions.empty(); };
     const BDD& blockCondition();               //@short computes the current block condition as conjunction of all conditions on stack.
     
-    void printError(string error_message,
+    void printError(string error_message,      //@short reports an error by throwing an AADD_Exception.
                     const int line=0,
                     string file_name="") const;
+    
+    friend class DDCheckpoint;                 // saves and restores the stack of block conditions.
 };
 
 blockMgrC& bCond();
 
+
+// explicit initialization and shutdown of the library; both are optional.
+void aaddInit(bool verbose=false);
+void aaddShutdown();
+
 #endif
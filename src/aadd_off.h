@@ -50,5 +50,9 @@ typedef bool   boolS;
 #define elseS else
 #define endS
 #define whileS while
+#define whileStateS(cond, ...) while (cond)
+
+// expressions of aadd_expr.h are evaluated immediately.
+inline double lazy(double x) { return x; }
 
 #endif
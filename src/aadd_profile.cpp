@@ -0,0 +1,212 @@
+/**
+
+ @file aadd_profile.cpp
+
+ @ingroup AADD
+
+ @brief Profiler of conditional and iteration statements; implementation.
+
+ @copyright@parblock
+ Copyright (c) 2017  Carna Radojicic, Christoph Grimm, Design of Cyber-Physical Systems
+ TU Kaiserslautern Postfach 3049 67663 Kaiserslautern radojicic@cs.uni-kl.de
+
+ This file is part of AADD package.
+
+ AADD is free software: you can redistribute it and/or modify it
+ under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ AADD is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public
+ License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with AADD package. If not, see <http://www.gnu.org/licenses/>.
+ @endparblock
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <algorithm>
+
+#include "aadd.h"
+
+
+/**
+ @brief The profiler is enabled if the environment variable AADD_PROFILE is set;
+ its value is the number of locations reported at the end of the program.
+ */
+profilerC::profilerC()
+{
+    const char* env = getenv("AADD_PROFILE");
+    enabled = (env != nullptr);
+    report_size = (env != nullptr and atoi(env) > 0) ? atoi(env) : 10;
+    cond.site = -1;
+    assign.site = -1;
+}
+
+profilerC& profiler()
+{
+    static profilerC instance;
+    return instance;
+}
+
+
+void profilerC::clear()
+{
+    all.clear();
+    index.clear();
+    clearBlocks();
+}
+
+void profilerC::clearBlocks()
+{
+    blocks.clear();
+    cond.site = -1;
+    assign.site = -1;
+}
+
+
+/**
+ @brief Starts the measurement of the evaluation of a condition at a location.
+ */
+void profilerC::startCond(const char* file, unsigned line, char kind)
+{
+    // the condition of a loop that has not been entered, e.g. the last one.
+    if (cond.site >= 0) stopCond(nullptr);
+
+    pair<const char*, unsigned> loc(file, line);
+    map<pair<const char*, unsigned>, int>::iterator i = index.find(loc);
+    if (i == index.end())
+    {
+        profileSite s = profileSite();
+        s.file = file;
+        s.line = line;
+        s.kind = kind;
+        all.push_back(s);
+        i = index.insert(make_pair(loc, (int) all.size()-1)).first;
+    }
+
+    cond.site  = i->second;
+    cond.lps   = lpCounters().calls;
+    cond.start = clock::now();
+}
+
+
+/**
+ @brief Stops the measurement of the condition c.
+ */
+void profilerC::stopCond(const BDD* c)
+{
+    if (cond.site < 0) return;
+
+    profileSite& s = all[cond.site];
+    s.entries++;
+    s.cond_seconds += std::chrono::duration<double>(clock::now()-cond.start).count();
+    s.cond_lps     += lpCounters().calls-cond.lps;
+    if (c != nullptr) s.cond_nodes += c->numNodes();
+    cond.site = -1;
+}
+
+
+/**
+ @brief Starts a block with the condition c; the measurement of c is stopped.
+ */
+void profilerC::startBlock(const BDD& c)
+{
+    int site = cond.site;
+    stopCond(&c);
+
+    frame f;
+    f.site  = site;
+    f.lps   = lpCounters().calls;
+    f.start = clock::now();
+    blocks.push_back(f);
+}
+
+
+void profilerC::stopBlock()
+{
+    if (blocks.empty()) return;
+
+    frame& f = blocks.back();
+    if (f.site >= 0)
+    {
+        profileSite& s = all[f.site];
+        s.blocks++;
+        s.block_seconds += std::chrono::duration<double>(clock::now()-f.start).count();
+        s.block_lps     += lpCounters().calls-f.lps;
+    }
+    blocks.pop_back();
+}
+
+
+/**
+ @brief Starts the measurement of an assignment to an AADD with the given number of leaves.
+ */
+void profilerC::beginAssign(unsigned leaves)
+{
+    if (!enabled or blocks.empty() or blocks.back().site < 0) return;
+
+    assign.site   = blocks.back().site;
+    assign.leaves = leaves;
+    assign.lps    = lpCounters().calls;
+    assign.start  = clock::now();
+}
+
+/**
+ @brief Stops the measurement of an assignment; leaves is the number of leaves of the result.
+ */
+void profilerC::endAssign(unsigned leaves)
+{
+    if (assign.site < 0) return;
+
+    profileSite& s = all[assign.site];
+    s.assigns++;
+    s.assign_seconds += std::chrono::duration<double>(clock::now()-assign.start).count();
+    s.assign_lps     += lpCounters().calls-assign.lps;
+    s.leaf_growth    += (long) leaves - (long) assign.leaves;
+    assign.site = -1;
+}
+
+
+vector<profileSite> profilerC::sites() const
+{
+    vector<profileSite> res = all;
+    sort(res.begin(), res.end(), [](const profileSite& a, const profileSite& b)
+         { return a.total() > b.total(); });
+    return res;
+}
+
+
+/**
+ @brief Prints the top locations by time of condition and assignments.
+ */
+void profilerC::report(ostream& s, unsigned top) const
+{
+    vector<profileSite> res = sites();
+    char line[512];
+
+    s << "AADD profile: top " << min(top, (unsigned) res.size()) << " of " << res.size() << " statements" << endl;
+    snprintf(line, sizeof(line), "%-32s %4s %8s %10s %7s %8s %10s %7s %8s %10s %7s %8s",
+             "location", "kind", "entries", "cond[ms]", "LPs", "nodes", "block[ms]", "LPs",
+             "assigns", "assign[ms]", "LPs", "growth");
+    s << line << endl;
+
+    for (unsigned i=0; i < res.size() and i < top; i++)
+    {
+        const profileSite& p = res[i];
+        string file = p.file;
+        size_t slash = file.find_last_of('/');
+        if (slash != string::npos) file = file.substr(slash+1);
+        string loc = file + ":" + to_string(p.line);
+
+        snprintf(line, sizeof(line), "%-32s %4s %8lu %10.3f %7lu %8lu %10.3f %7lu %8lu %10.3f %7lu %8ld",
+                 loc.c_str(), p.kind == 'w' ? "whl" : "if", p.entries, 1e3*p.cond_seconds, p.cond_lps,
+                 p.cond_nodes, 1e3*p.block_seconds, p.block_lps, p.assigns, 1e3*p.assign_seconds,
+                 p.assign_lps, p.leaf_growth);
+        s << line << endl;
+    }
+}
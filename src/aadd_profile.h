@@ -0,0 +1,138 @@
+/**
+
+ @file aadd_profile.h
+
+ @ingroup AADD
+
+ @brief Profiler that attributes cost to the conditional and iteration statements of a model.
+
+ @details The macros ifS and whileS register their source location with the profiler. For each
+ location, the profiler accumulates:
+ - the evaluation of the condition: time, LP calls and nodes of the condition BDD;
+ - the block up to elseS/endS: time and LP calls, including nested blocks;
+ - the assignments in the block, which are merged with the block condition: their number, time,
+   LP calls and the growth of the number of leaves of the assigned AADD.
+ Assignments are attributed to the innermost enclosing statement.
+ @details The profiler is disabled by default; then it costs one test per statement. It is
+ enabled by profiler().enable(), or by setting the environment variable AADD_PROFILE to the
+ number of locations to report at the end of the program.
+
+ @copyright@parblock
+ Copyright (c) 2017  Carna Radojicic, Christoph Grimm, Design of Cyber-Physical Systems
+ TU Kaiserslautern Postfach 3049 67663 Kaiserslautern radojicic@cs.uni-kl.de
+
+ This file is part of AADD package.
+
+ AADD is free software: you can redistribute it and/or modify it
+ under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ AADD is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public
+ License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with AADD package. If not, see <http://www.gnu.org/licenses/>.
+ @endparblock
+ */
+
+#ifndef aadd_profile_h
+#define aadd_profile_h
+
+#include <iostream>
+#include <vector>
+#include <map>
+#include <string>
+#include <chrono>
+
+using namespace std;
+
+class BDD;
+
+
+/**
+ @brief Accumulated cost of one ifS or whileS statement.
+ */
+struct profileSite
+{
+    const char*   file;
+    unsigned      line;
+    char          kind;             // 'i' for ifS, 'w' for whileS
+
+    unsigned long entries;          // evaluations of the condition
+    double        cond_seconds;
+    unsigned long cond_lps;
+    unsigned long cond_nodes;       // sum of the nodes of the condition BDD
+
+    unsigned long blocks;           // executions of the then/else part resp. loop body
+    double        block_seconds;    // including nested statements
+    unsigned long block_lps;
+
+    unsigned long assigns;          // assignments in the block
+    double        assign_seconds;
+    unsigned long assign_lps;
+    long          leaf_growth;      // leaves added to the assigned AADD
+
+    double total() const            { return cond_seconds+assign_seconds; };
+};
+
+
+/**
+ @brief The profiler of conditional and iteration statements.
+ */
+class profilerC
+{
+public:
+    profilerC();
+
+    void enable(bool on=true)                 { enabled = on; };
+    bool isEnabled() const                    { return enabled; };
+    void clear();
+    void clearBlocks();                       // forgets open blocks, e.g. after an exception.
+
+    // called by the macros ifS and whileS, and by blockMgrC.
+    void enterCond(const char* file, unsigned line, char kind)
+                                              { if (enabled) startCond(file, line, kind); };
+    bool loopTest(bool b)                     { if (enabled and !b) stopCond(nullptr); return b; };
+    void beginBlock(const BDD& cond)          { if (enabled) startBlock(cond); };
+    void endBlock()                           { if (enabled) stopBlock(); };
+
+    // called by assignments in a block.
+    void beginAssign(unsigned leaves);
+    void endAssign(unsigned leaves);
+
+    // locations sorted by decreasing time of condition and assignments.
+    vector<profileSite> sites() const;
+    void report(ostream& s = cout, unsigned top=10) const;
+    unsigned reportSize() const               { return report_size; };
+
+protected:
+    typedef std::chrono::steady_clock clock;
+
+    struct frame
+    {
+        int               site;
+        clock::time_point start;
+        unsigned long     lps;
+        unsigned          leaves;
+    };
+
+    bool enabled;
+    unsigned report_size;
+    vector<profileSite> all;
+    map<pair<const char*, unsigned>, int> index;   // location -> entry in all
+    frame         cond;                            // condition being evaluated; site is -1 if none
+    vector<frame> blocks;                          // stack of open blocks
+    frame         assign;
+
+    void startCond(const char* file, unsigned line, char kind);
+    void stopCond(const BDD* c);
+    void startBlock(const BDD& c);
+    void stopBlock();
+};
+
+profilerC& profiler();
+
+#endif /* aadd_profile_h */
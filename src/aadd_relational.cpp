@@ -33,6 +33,7 @@
 
 #include "aadd.h"
 #include "aadd_lp_glpk.h"
+#include "aadd_box.h"
 
 /**
  @brief Private Method of AADD called by relational operators
@@ -61,7 +62,7 @@ BDDNode* AADD::Compare(AADDNode* f,
     if (f->isLeaf() )
     {
         
-        AAF tmp=f->getValue();
+        const AAF& tmp=f->getValue();
         
         if (op=="==")
         {
@@ -78,7 +79,20 @@ BDDNode* AADD::Compare(AADDNode* f,
             
         }
         
-        bounds=solve_lp(tmp, constraints);
+        // the box of the path may decide without LP, or show that the path cannot hold.
+        bool decided = false;
+        if (lpOptions().contract_boxes)
+        {
+            if (noiseBox().isEmpty())
+            {
+                AADD_STAT_INC(box_pruned);
+                return zero;
+            }
+            noiseBox().bounds(tmp, bounds.min, bounds.max);
+            decided = bounds.max < threshold or bounds.min > threshold;
+            if (decided) AADD_STAT_INC(box_decided);
+        }
+        if (!decided) bounds=solve_lp(*f, constraints);
         
         if (bounds.max<threshold and !(fabs(bounds.max-threshold)<1e-20))
         {
@@ -128,18 +142,25 @@ BDDNode* AADD::Compare(AADDNode* f,
     /*Recursive step*/
   
     
+    const bool boxes = lpOptions().contract_boxes;
+    if (boxes and constraints.empty()) noiseBox().reset();
+    
     cons.con=f->getCond();
     
     cons.sign='+';
     
     constraints.push_back(cons);
     
+    if (boxes) noiseBox().push(cons.con, '+');
     T=Compare(f->getT(),threshold, constraints, op);
+    if (boxes) noiseBox().pop();
     if (T == NULL) return(NULL);
     
     constraints.back().sign='-';
     
+    if (boxes) noiseBox().push(cons.con, '-');
     E=Compare(f->getF(), threshold, constraints, op);
+    if (boxes) noiseBox().pop();
     
     if (E == NULL) {
         delete T;
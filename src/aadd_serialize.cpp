@@ -0,0 +1,490 @@
+/**
+
+ @file aadd_serialize.cpp
+
+ @ingroup AADD
+
+ @brief Binary format for saving and loading AADD and BDD; implementation.
+
+ @copyright@parblock
+ Copyright (c) 2017  Carna Radojicic, Christoph Grimm, Design of Cyber-Physical Systems
+ TU Kaiserslautern Postfach 3049 67663 Kaiserslautern radojicic@cs.uni-kl.de
+
+ This file is part of AADD package.
+
+ AADD is free software: you can redistribute it and/or modify it
+ under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ AADD is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public
+ License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with AADD package. If not, see <http://www.gnu.org/licenses/>.
+ @endparblock
+ */
+
+#include <string.h>
+#include <stdint.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <map>
+#include <fstream>
+
+#include "aadd_serialize.h"
+
+// limit of the depth of a diagram that is read, to bound the recursion on corrupted data.
+static const unsigned MAX_DEPTH = 10000;
+
+static const char magic[4] = { 'A', 'A', 'D', 'D' };
+
+
+/**
+ @brief Creates a writer and writes the header of the format to s.
+ */
+DDWriter::DDWriter(std::ostream& stream): s(stream)
+{
+    s.write(magic, 4);
+    putVarint(AADD_FORMAT_VERSION);
+}
+
+
+void DDWriter::putByte(unsigned char b)
+{
+    s.put((char) b);
+}
+
+/**
+ @brief Writes an unsigned LEB128 varint: 7 bits per byte, high bit set if more bytes follow.
+ */
+void DDWriter::putVarint(unsigned long v)
+{
+    while (v >= 0x80)
+    {
+        putByte((unsigned char)(v | 0x80));
+        v >>= 7;
+    }
+    putByte((unsigned char) v);
+}
+
+/**
+ @brief Writes a double as raw IEEE 754 bits in little endian byte order.
+ */
+void DDWriter::putDouble(double d)
+{
+    uint64_t bits;
+    memcpy(&bits, &d, sizeof(bits));
+    for (unsigned i=0; i < 8; i++)
+    {
+        putByte((unsigned char)(bits & 0xff));
+        bits >>= 8;
+    }
+}
+
+/**
+ @brief Writes an affine form; the noise symbol indexes are delta-encoded.
+ */
+void DDWriter::putForm(const FrozenDD& f, const frozenForm& form)
+{
+    putDouble(form.center);
+    putDouble(form.offset_min);
+    putDouble(form.offset_max);
+    putVarint(form.length);
+
+    unsigned prev = 0;
+    for (unsigned i=form.first; i < form.first+form.length; i++)
+    {
+        putVarint(f.getPoolIndexes()[i]-prev);
+        putDouble(f.getPoolDeviations()[i]);
+        prev = f.getPoolIndexes()[i];
+    }
+}
+
+/**
+ @brief Writes an AAF in the same encoding as the forms of a diagram record.
+ */
+void DDWriter::putAAF(const AAF& a)
+{
+    putDouble(a.getcenter());
+    putDouble(a.offset_min);
+    putDouble(a.offset_max);
+    putVarint(a.getlength());
+
+    unsigned prev = 0;
+    for (unsigned i=0; i < a.getlength(); i++)
+    {
+        putVarint(a.getIndexes()[i]-prev);
+        putDouble(a.getDeviations()[i]);
+        prev = a.getIndexes()[i];
+    }
+}
+
+
+/**
+ @brief Writes a diagram record of a frozen diagram.
+ @details If with_conds is false, the conditions are not written; the loader then
+ takes them from condMgr().
+ */
+void DDWriter::write(const FrozenDD& f, bool with_conds)
+{
+    putByte(f.isBDD() ? 'B' : 'A');
+
+    if (with_conds)
+    {
+        putVarint(f.getConds().size());
+        for (unsigned c=0; c < f.getConds().size(); c++)
+        {
+            putVarint(f.getCondIndexes()[c]);
+            putForm(f, f.getConds()[c]);
+        }
+    }
+    else putVarint(0);
+
+    putVarint(f.getLeaves().size());
+    for (unsigned l=0; l < f.getLeaves().size(); l++)
+        putForm(f, f.getLeaves()[l]);
+
+    // depth-first order of the records is the order of the format.
+    const vector<frozenNode>& nodes = f.getNodes();
+    putVarint(nodes.size());
+    for (unsigned r=0; r < nodes.size(); r++)
+    {
+        if (nodes[r].isLeaf()) putVarint(2*(unsigned long)nodes[r].form);
+        else putVarint(2*nodes[r].index+1);
+    }
+}
+
+void DDWriter::write(const AADD& a)
+{
+    frozen.freeze(a);
+    write(frozen);
+}
+
+void DDWriter::write(const BDD& b)
+{
+    frozen.freeze(b);
+    write(frozen);
+}
+
+
+/**
+ @brief Creates a reader of the buffer data and checks the header.
+ */
+DDReader::DDReader(const unsigned char* d, size_t s)
+{
+    data = d;
+    size = s;
+    pos  = 0;
+    error = (data == nullptr) or (size < 4) or (memcmp(data, magic, 4) != 0);
+    if (error) return;
+
+    pos = 4;
+    if (getVarint() != AADD_FORMAT_VERSION) error = true;
+}
+
+
+unsigned char DDReader::getByte()
+{
+    if (pos >= size)
+    {
+        error = true;
+        return 0;
+    }
+    return data[pos++];
+}
+
+unsigned long DDReader::getVarint()
+{
+    unsigned long v = 0;
+    for (unsigned shift=0; shift < 64; shift+=7)
+    {
+        unsigned char b = getByte();
+        v |= (unsigned long)(b & 0x7f) << shift;
+        if (!(b & 0x80)) return v;
+    }
+    error = true;
+    return 0;
+}
+
+double DDReader::getDouble()
+{
+    uint64_t bits = 0;
+    for (unsigned i=0; i < 8; i++)
+        bits |= (uint64_t) getByte() << (8*i);
+
+    double d;
+    memcpy(&d, &bits, sizeof(d));
+    return d;
+}
+
+
+/**
+ @brief Reads an affine form into the pool of a frozen diagram and appends it to table.
+ */
+bool DDReader::getForm(FrozenDD& f, vector<frozenForm>& table)
+{
+    frozenForm form;
+    form.center     = getDouble();
+    form.offset_min = getDouble();
+    form.offset_max = getDouble();
+    form.length     = getVarint();
+    form.first      = f.poolIndexes().size();
+
+    // each coefficient needs at least 9 bytes.
+    if (error or form.length > (size-pos)/9) return !(error = true);
+
+    unsigned idx = 0;
+    for (unsigned i=0; i < form.length; i++)
+    {
+        idx += getVarint();
+        f.poolIndexes().push_back(idx);
+        f.poolDeviations().push_back(getDouble());
+    }
+    table.push_back(form);
+    return !error;
+}
+
+/**
+ @brief Reads an AAF written by DDWriter::putAAF.
+ */
+AAF DDReader::getAAF()
+{
+    FrozenDD tmp;
+    vector<frozenForm> table;
+    if (!getForm(tmp, table)) return AAF(0.0);
+    return tmp.getAAF(table[0]);
+}
+
+
+/**
+ @brief Reads the subtree of a node in depth-first order.
+ @return record of the node.
+ */
+unsigned DDReader::getNode(FrozenDD& f, unsigned depth)
+{
+    vector<frozenNode>& nodes = f.nodeRecords();
+    unsigned rec = nodes.size();
+
+    unsigned long v = getVarint();
+    nodes.push_back(frozenNode());
+    nodes[rec].T = nodes[rec].F = 0;
+
+    if (v % 2 == 0) // leaf
+    {
+        nodes[rec].index = MAXINDEX;
+        nodes[rec].form  = v/2;
+        if ( f.isBDD() ? (v/2 > 1) : (v/2 >= f.leafTable().size()) ) error = true;
+        return rec;
+    }
+
+    // conditions are ordered on a path, so a path has at most one node per condition.
+    if (depth >= f.condIndexes().size() or depth >= MAX_DEPTH) error = true;
+    if (error) return rec;
+
+    map<unsigned long, unsigned>::const_iterator slot = slots.find(v/2);
+    if (slot == slots.end())
+    {
+        error = true;
+        return rec;
+    }
+    nodes[rec].index = v/2;
+    nodes[rec].form  = slot->second;
+
+    unsigned T = getNode(f, depth+1);
+    if (error) return rec;
+    unsigned F = getNode(f, depth+1);
+    nodes[rec].T = T;
+    nodes[rec].F = F;
+    return rec;
+}
+
+
+/**
+ @brief Reads the next diagram record into a frozen diagram.
+ @details If add_conds is true, the conditions of the record are added to condMgr(), and the
+ condition indexes of the nodes are changed to the new ones. If the record has no conditions,
+ they are taken from condMgr().
+ @return true if successful.
+ */
+bool DDReader::read(FrozenDD& f, bool add_conds)
+{
+    f.clear();
+    unsigned char kind = getByte();
+    if (kind != 'A' and kind != 'B') error = true;
+    if (error) return false;
+    f.setBDD(kind == 'B');
+
+    unsigned long ncond = getVarint();
+    for (unsigned long c=0; c < ncond and !error; c++)
+    {
+        f.condIndexes().push_back(getVarint());
+        getForm(f, f.condTable());
+    }
+
+    unsigned long nleaf = getVarint();
+    for (unsigned long l=0; l < nleaf and !error; l++)
+        getForm(f, f.leafTable());
+
+    unsigned long nnode = getVarint();
+    if (error or nnode == 0 or nnode > size-pos) return !(error = true);
+
+    slots.clear();
+    for (unsigned c=0; c < f.condIndexes().size(); c++)
+        slots[f.condIndexes()[c]] = c;
+
+    bool own_conds = (ncond > 0);
+    if (!own_conds)
+    {
+        // conditions are in condMgr(); take the ones used by the nodes into the table.
+        size_t start = pos;
+        for (unsigned long r=0; r < nnode and !error; r++)
+        {
+            unsigned long v = getVarint();
+            if (v % 2 == 0) continue;
+            unsigned long index = v/2;
+            if (index >= condMgr().size()) return !(error = true);
+            if (slots.count(index) == 0)
+            {
+                slots[index] = f.addForm(f.condTable(), condMgr().getCond(index));
+                f.condIndexes().push_back(index);
+            }
+        }
+        pos = start;
+    }
+
+    getNode(f, 0);
+    if (error or f.nodeRecords().size() != nnode) return !(error = true);
+
+    if (add_conds and own_conds)
+    {
+        // add conditions in the order of their old indexes to keep their relative order.
+        vector<unsigned> order(f.condIndexes().size());
+        for (unsigned c=0; c < order.size(); c++) order[c] = c;
+        sort(order.begin(), order.end(), [&f](unsigned a, unsigned b)
+             { return f.condIndexes()[a] < f.condIndexes()[b]; });
+
+        for (unsigned c=0; c < order.size(); c++)
+            f.condIndexes()[order[c]] = condMgr().addCond(f.getAAF(f.condTable()[order[c]]));
+
+        for (unsigned r=0; r < f.nodeRecords().size(); r++)
+        {
+            frozenNode& n = f.nodeRecords()[r];
+            if (!n.isLeaf()) n.index = f.condIndexes()[n.form];
+        }
+    }
+    return true;
+}
+
+
+/**
+ @brief Reads the next diagram record into an AADD; adds its conditions to condMgr().
+ @details The root of a is replaced, without considering block conditions.
+ @return true if successful.
+ */
+bool DDReader::read(AADD& a)
+{
+    FrozenDD f;
+    if (peekKind() != 'A' or !read(f)) return !(error = true);
+    a.setRoot(f.thawAADD());
+    return true;
+}
+
+/**
+ @brief Reads the next diagram record into a BDD; adds its conditions to condMgr().
+ @see read(AADD&)
+ */
+bool DDReader::read(BDD& b)
+{
+    FrozenDD f;
+    if (peekKind() != 'B' or !read(f)) return !(error = true);
+    b.setRoot(f.thawBDD());
+    return true;
+}
+
+
+/**
+ @brief Maps a file into memory for reading.
+ @details If the file cannot be opened or mapped, isOpen() returns false.
+ */
+DDMappedFile::DDMappedFile(const string& file_name)
+{
+    data = nullptr;
+    size = 0;
+
+    int fd = open(file_name.c_str(), O_RDONLY);
+    if (fd < 0) return;
+
+    struct stat st;
+    if (fstat(fd, &st) == 0 and st.st_size > 0)
+    {
+        void* p = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p != MAP_FAILED)
+        {
+            data = (unsigned char*) p;
+            size = st.st_size;
+        }
+    }
+    close(fd);
+}
+
+DDMappedFile::~DDMappedFile()
+{
+    if (data != nullptr) munmap(data, size);
+}
+
+
+/**
+ @brief Saves the AADD to a file in the binary format.
+ @return 0 if no error or 1 in case of error
+ */
+int AADD::save(string file_name) const
+{
+    std::ofstream s(file_name.c_str(), std::ios::binary);
+    DDWriter w(s);
+    w.write(*this);
+    s.close();
+    return s.fail() ? 1 : 0;
+}
+
+/**
+ @brief Loads the AADD from a file in the binary format, written by save.
+ @details The conditions of the AADD are added to the condition manager.
+ @return 0 if no error or 1 in case of error; then the AADD is not changed.
+ */
+int AADD::load(string file_name)
+{
+    DDMappedFile file(file_name);
+    DDReader r(file.getData(), file.getSize());
+    return r.read(*this) ? 0 : 1;
+}
+
+/**
+ @brief Saves the BDD to a file in the binary format.
+ @return 0 if no error or 1 in case of error
+ */
+int BDD::save(string file_name) const
+{
+    std::ofstream s(file_name.c_str(), std::ios::binary);
+    DDWriter w(s);
+    w.write(*this);
+    s.close();
+    return s.fail() ? 1 : 0;
+}
+
+/**
+ @brief Loads the BDD from a file in the binary format, written by save.
+ @see AADD::load
+ */
+int BDD::load(string file_name)
+{
+    DDMappedFile file(file_name);
+    DDReader r(file.getData(), file.getSize());
+    return r.read(*this) ? 0 : 1;
+}
@@ -0,0 +1,148 @@
+/**
+
+ @file aadd_serialize.h
+
+ @ingroup AADD
+
+ @brief Compact binary format for saving and loading AADD and BDD.
+
+ @details A file starts with the magic bytes "AADD" and the format version. It is followed by
+ a sequence of diagram records. Each record stores the referenced conditions, the leaf affine
+ forms and the topology of the diagram:
+ @verbatim
+   record  := kind ncond {cindex form} nleaf {form} nnode {node}
+   kind    := 'A' (AADD) | 'B' (BDD)
+   form    := center offset_min offset_max length {delta deviation}
+   node    := 2*leaf (leaf form resp. truth value) | 2*cindex+1 (internal node)
+ @endverbatim
+ Counts, indexes and index deltas are unsigned LEB128 varints, doubles are raw IEEE 754 in
+ little endian byte order. Nodes are written in depth-first order, true child first; each node
+ is written once. Noise symbol indexes of a form are delta-encoded.
+ @details On loading, the conditions of a record are added to condMgr() and the nodes are
+ mapped to the new condition indexes, preserving their relative order. A record may omit
+ conditions that are already in condMgr() with the same index, e.g. because they have been
+ restored from a checkpoint before.
+ @details The reader works on a memory buffer; files are mapped into memory with mmap.
+
+ @copyright@parblock
+ Copyright (c) 2017  Carna Radojicic, Christoph Grimm, Design of Cyber-Physical Systems
+ TU Kaiserslautern Postfach 3049 67663 Kaiserslautern radojicic@cs.uni-kl.de
+
+ This file is part of AADD package.
+
+ AADD is free software: you can redistribute it and/or modify it
+ under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ AADD is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public
+ License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with AADD package. If not, see <http://www.gnu.org/licenses/>.
+ @endparblock
+ */
+
+#ifndef aadd_serialize_h
+#define aadd_serialize_h
+
+#include <iostream>
+#include <string>
+#include <map>
+#include <stddef.h>
+
+#include "aadd_frozen.h"
+
+// @brief Version of the binary format; increased with incompatible changes.
+const unsigned AADD_FORMAT_VERSION = 1;
+
+
+/**
+ @brief Streaming writer of the binary format.
+ @details The header is written by the constructor; each call of write appends a diagram record.
+ */
+class DDWriter
+{
+public:
+    DDWriter(std::ostream& s);
+
+    void write(const AADD&);
+    void write(const BDD&);
+    void write(const FrozenDD&, bool with_conds=true);
+
+    // encoding of the elements of the format
+    void putByte(unsigned char);
+    void putVarint(unsigned long);
+    void putDouble(double);
+    void putAAF(const AAF&);
+
+    bool good() const              { return s.good(); };
+
+protected:
+    std::ostream& s;
+    FrozenDD frozen;               // reused for each record.
+
+    void putForm(const FrozenDD&, const frozenForm&);
+};
+
+
+/**
+ @brief Reader of the binary format from a memory buffer.
+ @details All methods return false resp. set the error flag if the data is corrupted
+ or ends unexpectedly; the process is never terminated.
+ */
+class DDReader
+{
+public:
+    DDReader(const unsigned char* data, size_t size);
+
+    bool read(AADD&);
+    bool read(BDD&);
+    bool read(FrozenDD&, bool add_conds=true);
+
+    bool atEnd() const             { return pos >= size; };
+    bool failed() const            { return error; };
+    unsigned char peekKind() const { return atEnd() ? 0 : data[pos]; };
+
+    // decoding of the elements of the format
+    unsigned char getByte();
+    unsigned long getVarint();
+    double getDouble();
+    AAF getAAF();
+
+protected:
+    const unsigned char* data;
+    size_t size;
+    size_t pos;
+    bool   error;
+    map<unsigned long, unsigned> slots;   // entry in condition table of a condition index.
+
+    bool getForm(FrozenDD&, vector<frozenForm>&);
+    unsigned getNode(FrozenDD&, unsigned depth);
+};
+
+
+/**
+ @brief A file that is mapped into memory for reading.
+ */
+class DDMappedFile
+{
+public:
+    DDMappedFile(const string& file_name);
+    ~DDMappedFile();
+
+    bool isOpen() const                  { return data != nullptr; };
+    const unsigned char* getData() const { return data; };
+    size_t getSize() const               { return size; };
+
+private:
+    unsigned char* data;
+    size_t size;
+
+    DDMappedFile(const DDMappedFile&);            // not copyable
+    DDMappedFile& operator=(const DDMappedFile&);
+};
+
+#endif /* aadd_serialize_h */
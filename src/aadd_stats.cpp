@@ -0,0 +1,98 @@
+/**
+
+ @file aadd_stats.cpp
+
+ @ingroup AADD
+
+ @brief Counters of the operations on the hot paths of the library; implementation.
+
+ @copyright@parblock
+ Copyright (c) 2017  Carna Radojicic, Christoph Grimm, Design of Cyber-Physical Systems
+ TU Kaiserslautern Postfach 3049 67663 Kaiserslautern radojicic@cs.uni-kl.de
+
+ This file is part of AADD package.
+
+ AADD is free software: you can redistribute it and/or modify it
+ under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ AADD is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public
+ License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with AADD package. If not, see <http://www.gnu.org/licenses/>.
+ @endparblock
+ */
+
+#include "aadd.h"
+#include "aadd_stats.h"
+
+
+//@short static instance of the counters; zero-initialized before any constructor runs.
+static aadd_statistics statistics;
+
+aadd_statistics& aaddStats()
+{
+    return statistics;
+}
+
+
+void aadd_statistics::reset()
+{
+    node_allocs = 0;
+    apply_calls = 0;
+    lp_calls = 0;
+    lp_nanoseconds = 0;
+    simplex_iterations = 0;
+    glpk_calls = 0;
+    lp_closed_form = 0;
+    lp_presolved_cols = 0;
+    lp_cache_hits = 0;
+    box_pruned = 0;
+    box_decided = 0;
+    conds_added = 0;
+    aaf_allocs = 0;
+    max_aaf_length = 0;
+}
+
+
+void aadd_statistics::updateMax(unsigned length)
+{
+    unsigned max = max_aaf_length.load(std::memory_order_relaxed);
+    while (length > max and !max_aaf_length.compare_exchange_weak(max, length, std::memory_order_relaxed))
+        ;
+}
+
+
+/**
+ @brief Writes the counters as a JSON object.
+ */
+void aadd_statistics::printJSON(std::ostream& s) const
+{
+#ifdef AADD_STATISTICS
+    bool enabled = true;
+#else
+    bool enabled = false;
+#endif
+    s << "{" << endl
+      << "  \"enabled\": " << (enabled ? "true" : "false") << "," << endl
+      << "  \"node_allocs\": " << node_allocs << "," << endl
+      << "  \"apply_calls\": " << apply_calls << "," << endl
+      << "  \"lp_calls\": " << lp_calls << "," << endl
+      << "  \"lp_seconds\": " << lp_nanoseconds*1e-9 << "," << endl
+      << "  \"simplex_iterations\": " << simplex_iterations << "," << endl
+      << "  \"glpk_calls\": " << glpk_calls << "," << endl
+      << "  \"lp_closed_form\": " << lp_closed_form << "," << endl
+      << "  \"lp_presolved_cols\": " << lp_presolved_cols << "," << endl
+      << "  \"lp_cache_hits\": " << lp_cache_hits << "," << endl
+      << "  \"box_pruned\": " << box_pruned << "," << endl
+      << "  \"box_decided\": " << box_decided << "," << endl
+      << "  \"conds_added\": " << conds_added << "," << endl
+      << "  \"aaf_allocs\": " << aaf_allocs << "," << endl
+      << "  \"max_aaf_length\": " << max_aaf_length << "," << endl
+      << "  \"max_symbol\": " << AAF::getDefault() << endl
+      << "}" << endl;
+}
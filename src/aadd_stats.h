@@ -0,0 +1,84 @@
+/**
+
+ @file aadd_stats.h
+
+ @ingroup AADD
+
+ @brief Counters of the operations on the hot paths of the library.
+
+ @details The counters are compiled in only if AADD_STATISTICS is defined in aadd_config.h;
+ it is set by the CMake option AADD_STATISTICS. Otherwise, the macros below expand to nothing
+ and aaddStats() returns zero counters. The counters are atomic and can be incremented from
+ several threads.
+ @details At the end of the program, the counters are written as JSON to the file that is
+ given by the environment variable AADD_STATS_JSON, if it is set.
+
+ @copyright@parblock
+ Copyright (c) 2017  Carna Radojicic, Christoph Grimm, Design of Cyber-Physical Systems
+ TU Kaiserslautern Postfach 3049 67663 Kaiserslautern radojicic@cs.uni-kl.de
+
+ This file is part of AADD package.
+
+ AADD is free software: you can redistribute it and/or modify it
+ under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ AADD is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public
+ License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with AADD package. If not, see <http://www.gnu.org/licenses/>.
+ @endparblock
+ */
+
+#ifndef aadd_stats_h
+#define aadd_stats_h
+
+#include <atomic>
+#include <iostream>
+
+#include "aadd_config.h"
+
+
+/**
+ @brief Counters of the operations of the library.
+ */
+struct aadd_statistics
+{
+    std::atomic<unsigned long> node_allocs;         // nodes of AADD and BDD created
+    std::atomic<unsigned long> apply_calls;         // calls of Apply, including recursive ones
+    std::atomic<unsigned long> lp_calls;            // LPs solved by solve_lp
+    std::atomic<unsigned long> lp_nanoseconds;      // time spent in solve_lp
+    std::atomic<unsigned long> simplex_iterations;  // iterations of the simplex method
+    std::atomic<unsigned long> glpk_calls;          // LPs of solve_lp that were solved by GLPK
+    std::atomic<unsigned long> lp_closed_form;      // LPs of solve_lp that were solved in closed form
+    std::atomic<unsigned long> lp_presolved_cols;   // columns removed from LPs by the presolve
+    std::atomic<unsigned long> lp_cache_hits;       // bounds of leaves reused from their cache
+    std::atomic<unsigned long> box_pruned;          // paths pruned because their box is empty
+    std::atomic<unsigned long> box_decided;         // comparisons decided by the box of a leaf
+    std::atomic<unsigned long> conds_added;         // calls of condMgrC::addCond
+    std::atomic<unsigned long> aaf_allocs;          // affine forms created
+    std::atomic<unsigned>      max_aaf_length;      // maximum number of noise symbols of an affine form
+
+    void reset();
+    void updateMax(unsigned length);
+    void printJSON(std::ostream& s = std::cout) const;
+};
+
+aadd_statistics& aaddStats();
+
+
+#ifdef AADD_STATISTICS
+#define AADD_STAT_INC(counter)     (aaddStats().counter.fetch_add(1, std::memory_order_relaxed))
+#define AADD_STAT_ADD(counter, n)  (aaddStats().counter.fetch_add((n), std::memory_order_relaxed))
+#define AADD_STAT_LENGTH(length)   (aaddStats().updateMax(length))
+#else
+#define AADD_STAT_INC(counter)     ((void) 0)
+#define AADD_STAT_ADD(counter, n)  ((void) 0)
+#define AADD_STAT_LENGTH(length)   ((void) 0)
+#endif
+
+#endif /* aadd_stats_h */
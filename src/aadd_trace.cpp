@@ -0,0 +1,194 @@
+/**
+
+ @file aadd_trace.cpp
+
+ @ingroup AADD
+
+ @brief Buffered binary trace of the bounds of an AADD over time; implementation.
+
+ @copyright@parblock
+ Copyright (c) 2017  Carna Radojicic, Christoph Grimm, Design of Cyber-Physical Systems
+ TU Kaiserslautern Postfach 3049 67663 Kaiserslautern radojicic@cs.uni-kl.de
+
+ This file is part of AADD package.
+
+ AADD is free software: you can redistribute it and/or modify it
+ under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ AADD is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public
+ License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with AADD package. If not, see <http://www.gnu.org/licenses/>.
+ @endparblock
+ */
+
+#include "aadd_trace.h"
+
+
+/**
+ @brief Opens the trace file and starts the background thread.
+ @param batch_size number of records that are written at once.
+ @param max_pending maximum number of records that wait for the background thread.
+ */
+DDTraceWriter::DDTraceWriter(const string& file_name, unsigned bsize, unsigned mpending):
+    file(file_name.c_str(), std::ios::binary)
+{
+    batch_size  = bsize > 0 ? bsize : 1;
+    max_pending = mpending > 0 ? mpending : 1;
+    recorded = written = 0;
+    flushing = stop = false;
+
+    writer = new DDWriter(file);
+    writer->putByte('T');
+
+    batch.reserve(batch_size);
+    worker = std::thread(&DDTraceWriter::run, this);
+}
+
+
+/**
+ @brief Writes all pending records, stops the background thread and closes the file.
+ */
+DDTraceWriter::~DDTraceWriter()
+{
+    flush();
+    {
+        std::lock_guard<std::mutex> l(lock);
+        stop = true;
+    }
+    work_cond.notify_one();
+    worker.join();
+
+    delete writer;
+    file.close();
+}
+
+
+/**
+ @brief Records the bounds of the AADD value at the given time.
+ @details The bounds are computed by the calling thread, as GetBothBounds uses the
+ lpOptions() of the thread and shared state of the affine forms. Only the record
+ is handed to the background thread.
+ */
+void DDTraceWriter::record(double time, const AADD& value)
+{
+    traceRecord r;
+    opt_sol bounds = value.GetBothBounds();
+    r.time   = time;
+    r.min    = bounds.min;
+    r.max    = bounds.max;
+    r.leaves = value.numLeaves();
+
+    {
+        std::unique_lock<std::mutex> l(lock);
+        done_cond.wait(l, [this]{ return pending.size() < max_pending; });
+        pending.push_back(r);
+        recorded++;
+    }
+    work_cond.notify_one();
+}
+
+
+/**
+ @brief Waits until all records taken so far are written to the file.
+ */
+void DDTraceWriter::flush()
+{
+    std::unique_lock<std::mutex> l(lock);
+    flushing = true;
+    work_cond.notify_one();
+    done_cond.wait(l, [this]{ return written == recorded; });
+    flushing = false;
+    file.flush();
+}
+
+
+/**
+ @brief Writes the records of the batch in columnar layout.
+ */
+void DDTraceWriter::writeBatch()
+{
+    writer->putVarint(batch.size());
+    for (unsigned r=0; r < batch.size(); r++) writer->putDouble(batch[r].time);
+    for (unsigned r=0; r < batch.size(); r++) writer->putDouble(batch[r].min);
+    for (unsigned r=0; r < batch.size(); r++) writer->putDouble(batch[r].max);
+    for (unsigned r=0; r < batch.size(); r++) writer->putVarint(batch[r].leaves);
+}
+
+
+/**
+ @brief Main loop of the background thread.
+ @details Moves the pending records to the batch and writes it if it is full,
+ or if a flush is requested and no records are pending.
+ */
+void DDTraceWriter::run()
+{
+    std::unique_lock<std::mutex> l(lock);
+    while (true)
+    {
+        work_cond.wait(l, [this]{ return stop or !pending.empty() or (flushing and !batch.empty()); });
+
+        if (pending.empty())
+        {
+            if (!batch.empty())
+            {
+                unsigned n = batch.size();
+                l.unlock();
+                writeBatch();
+                batch.clear();
+                l.lock();
+                written += n;
+                done_cond.notify_all();
+            }
+            if (stop) return;
+            continue;
+        }
+
+        while (!pending.empty() and batch.size() < batch_size)
+        {
+            batch.push_back(pending.front());
+            pending.pop_front();
+        }
+        done_cond.notify_all();
+        if (batch.size() < batch_size) continue;
+
+        unsigned n = batch.size();
+        l.unlock();
+        writeBatch();
+        batch.clear();
+        l.lock();
+        written += n;
+        done_cond.notify_all();
+    }
+}
+
+
+/**
+ @brief Reads all records of a trace file.
+ @return 0 if no error or 1 in case of error
+ */
+int DDTraceWriter::readTrace(const string& file_name, vector<traceRecord>& records)
+{
+    DDMappedFile file(file_name);
+    DDReader r(file.getData(), file.getSize());
+    if (r.getByte() != 'T') return 1;
+
+    while (!r.atEnd() and !r.failed())
+    {
+        unsigned long n = r.getVarint();
+        if (n > file.getSize()) return 1;
+
+        size_t first = records.size();
+        records.resize(first+n);
+        for (unsigned long i=0; i < n; i++) records[first+i].time   = r.getDouble();
+        for (unsigned long i=0; i < n; i++) records[first+i].min    = r.getDouble();
+        for (unsigned long i=0; i < n; i++) records[first+i].max    = r.getDouble();
+        for (unsigned long i=0; i < n; i++) records[first+i].leaves = r.getVarint();
+    }
+    return r.failed() ? 1 : 0;
+}
@@ -0,0 +1,106 @@
+/**
+
+ @file aadd_trace.h
+
+ @ingroup AADD
+
+ @brief Buffered binary trace of the bounds of an AADD over time.
+
+ @details The trace writer computes the bounds of an AADD on the simulation thread, with the
+ lpOptions() of that thread, and hands the records to a background thread. The background
+ thread only collects the records and writes them in batches to a file, so that the simulation
+ does not wait for the file.
+ @details The file starts with the header of the binary format (aadd_serialize.h) and the
+ kind 'T', followed by batches in columnar layout:
+ @verbatim
+   batch := count {time} {min} {max} {leaves}
+ @endverbatim
+ Times and bounds are raw doubles; the numbers of leaves are varints.
+
+ @copyright@parblock
+ Copyright (c) 2017  Carna Radojicic, Christoph Grimm, Design of Cyber-Physical Systems
+ TU Kaiserslautern Postfach 3049 67663 Kaiserslautern radojicic@cs.uni-kl.de
+
+ This file is part of AADD package.
+
+ AADD is free software: you can redistribute it and/or modify it
+ under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ AADD is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public
+ License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with AADD package. If not, see <http://www.gnu.org/licenses/>.
+ @endparblock
+ */
+
+#ifndef aadd_trace_h
+#define aadd_trace_h
+
+#include <fstream>
+#include <string>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include "aadd_serialize.h"
+
+
+/**
+ @brief One entry of a trace: the bounds of an AADD at a time.
+ */
+struct traceRecord
+{
+    double   time;
+    double   min, max;
+    unsigned leaves;
+};
+
+
+/**
+ @brief Writes the bounds of an AADD at each time step to a binary trace file.
+ @details record() computes the bounds of the AADD and returns; the records are written by
+ a background thread. If more than max_pending records wait to be written, record()
+ waits for the background thread. The destructor writes all pending records.
+ */
+class DDTraceWriter
+{
+public:
+    DDTraceWriter(const string& file_name, unsigned batch_size=256, unsigned max_pending=1024);
+    ~DDTraceWriter();
+
+    bool isOpen() const          { return file.is_open(); };
+
+    void record(double time, const AADD& value);  // bounds of value at time.
+    void flush();                                 // waits until all records are written.
+
+    // reads all records of a trace file; returns 0 if no error or 1 in case of error.
+    static int readTrace(const string& file_name, vector<traceRecord>& records);
+
+protected:
+    std::ofstream file;
+    DDWriter*     writer;
+    unsigned      batch_size;
+    unsigned      max_pending;
+
+    std::mutex              lock;
+    std::condition_variable work_cond;   // signals new records or stop to worker.
+    std::condition_variable done_cond;   // signals processed records to record and flush.
+    deque<traceRecord> pending;          // records waiting for the worker.
+    unsigned long     recorded, written;
+    bool              flushing, stop;
+    std::thread       worker;
+
+    vector<traceRecord> batch;           // used by worker only.
+
+    void run();
+    void writeBatch();
+};
+
+#endif /* aadd_trace_h */
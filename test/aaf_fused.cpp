@@ -0,0 +1,91 @@
+#include "../src/aadd.h"
+#include <assert.h>
+#include <math.h>
+
+//
+// Checks the fused affine combinations and the operators on temporaries against the binary AAF operators.
+//
+bool same(const AAF& a, const AAF& b)
+{
+    if (fabs(a.getcenter() - b.getcenter()) > 1e-12) return false;
+    if (fabs(a.rad() - b.rad()) > 1e-12) return false;
+    unsigned last = max(a.getLastIndex(), b.getLastIndex());
+    for (unsigned i=0; i <= last; i++)
+        if (fabs(a.at(i) - b.at(i)) > 1e-12) return false;
+    return a.offset_min == b.offset_min && a.offset_max == b.offset_max;
+}
+
+int main()
+{
+    AAF x(0, 2);        // 1+e1
+    AAF y(-1, 1);       // e2
+    AAF z(3, 5);        // 4+e3
+    AAF xy = x + y*0.5; // shares e1 and e2
+
+    // a*x + b*y + c
+    assert( same(lincomb(2., x, -3., xy, 1.), x*2. + xy*(-3.) + AAF(1.)) );
+    assert( same(lincomb(0., x, 1., y), y) );
+
+    // sum of w[i]*x[i]
+    const AAF* t[4] = {&x, &y, &z, &xy};
+    double w[4] = {1., 2., -0.5, 4.};
+    assert( same(lincomb(4, w, t, 0.25), x + y*2. + z*(-0.5) + xy*4. + AAF(0.25)) );
+
+    // axpy in place and with new noise symbols
+    AAF acc = xy;
+    acc.axpy(3., x);
+    assert( same(acc, xy + x*3.) );
+    acc.axpy(-1., z);
+    assert( same(acc, xy + x*3. - z) );
+    acc.axpy(1., acc);
+    assert( same(acc, (xy + x*3. - z)*2.) );
+
+    // constants only
+    AAF c = lincomb(2., AAF(1.), 3., AAF(2.), 1.);
+    assert( c.getlength() == 0 && c.getcenter() == 9. );
+
+    // operators on temporaries reuse their memory, with the same results.
+    AAF zo = z;
+    zo.offset_min = -0.5;
+    zo.offset_max = 0.25;
+    assert( same(AAF(x) + y, x + y) );
+    assert( same(AAF(xy) - zo, xy - zo) );
+
+    // each operator on a temporary against the same operator on a named copy, on operands
+    // with partly shared noise symbols and offsets.
+    AAF xo = xy + x*0.5;
+    xo.offset_min = -0.125;
+    xo.offset_max = 0.375;
+    AAF yo = y*2. + z;
+    yo.offset_min = -0.25;
+    yo.offset_max = 0.5;
+    const AAF* ops[4] = {&xo, &yo, &zo, &c};
+    for (unsigned i=0; i < 4; i++)
+        for (unsigned j=0; j < 4; j++)
+        {
+            const AAF& a = *ops[i];
+            const AAF& b = *ops[j];
+            AAF l = a;
+            assert( same(AAF(a) + b, l + b) );
+            assert( same(AAF(a) - b, l - b) );
+        }
+    for (unsigned i=0; i < 4; i++)
+    {
+        AAF l = *ops[i];
+        assert( same(-AAF(l), -l) );
+        assert( same(AAF(l)*2.5, l*2.5) );
+        assert( same(AAF(l)*-1.5, l*-1.5) );
+        assert( same(AAF(l) + l, l + l) );
+        assert( same(AAF(l) - l, l - l) );
+    }
+    AAF diff = AAF(zo) - xy;
+    assert( diff.offset_min == zo.offset_min && diff.offset_max == zo.offset_max );
+
+    // moving leaves an empty affine form.
+    AAF moved(std::move(acc));
+    assert( acc.getlength() == 0 && moved.getlength() == 3 );
+    acc = std::move(moved);
+    assert( acc.getlength() == 3 );
+
+    cout << "Fused AAF operations passed." << endl;
+}
@@ -0,0 +1,56 @@
+#include "../src/aadd.h"
+#include <assert.h>
+#include <math.h>
+
+//
+// Checks that the bounds of leaves are cached and recomputed when they may have changed.
+//
+int main()
+{
+    AADD a = doubleS(-1.0, 1.0);
+    ifS (a > 0.5)
+        a = a*2.0;
+    endS;
+    ifS (a < -0.5)
+        a = a+1.0;
+    endS;
+
+    lpOptions().cache_bounds = true;
+    lpCounters() = lp_counters();
+    opt_sol first = a.GetBothBounds();
+    unsigned long calls = lpCounters().calls;
+    assert( calls > 0 );
+
+    // the same query and a copy reuse the bounds.
+    opt_sol again = a.GetBothBounds();
+    assert( lpCounters().calls == calls );
+    AADD b = a;
+    opt_sol copied = b.GetBothBounds();
+    assert( lpCounters().calls == calls );
+    assert( again.min == first.min and again.max == first.max );
+    assert( copied.min == first.min and copied.max == first.max );
+
+    // other options and a disabled cache compute them again.
+    lpOptions().solver = LP_SOLVER_GLPK;
+    opt_sol glpk = a.GetBothBounds();
+    assert( lpCounters().calls == 2*calls );
+    assert( fabs(glpk.min-first.min) < 1e-9 and fabs(glpk.max-first.max) < 1e-9 );
+    lpOptions().solver = LP_SOLVER_AUTO;
+    lpOptions().cache_bounds = false;
+    a.GetBothBounds();
+    assert( lpCounters().calls == 3*calls );
+    lpOptions().cache_bounds = true;
+    lpOptions().contract_boxes = true;
+    a.GetBothBounds();
+    assert( lpCounters().calls > 3*calls );
+    lpOptions().contract_boxes = false;
+
+    // a new value of a leaf drops its bounds.
+    AADD c = doubleS(0.0, 1.0);
+    opt_sol before = c.GetBothBounds();
+    assert( before.min == 0.0 and before.max == 1.0 );
+    c.getRoot()->setValue(AAF(5.0));
+    opt_sol after = c.GetBothBounds();
+    assert( after.min == 5.0 and after.max == 5.0 );
+    return 0;
+}
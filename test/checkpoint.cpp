@@ -0,0 +1,162 @@
+#include "../src/aadd.h"
+#include "../src/aadd_checkpoint.h"
+#include <assert.h>
+#include <sstream>
+
+//
+// Checks that a run continued from a checkpoint gives the same result as the original run.
+//
+static doubleS level, rate;
+
+// true if the nodes of all live diagrams have the index of an existing condition.
+template<class ValT>
+static bool validIndexes(const DDNode<ValT>* f)
+{
+    if (f->isLeaf()) return true;
+    if (f->getIndex() >= condMgr().size()) return false;
+    return validIndexes(f->getT()) and validIndexes(f->getF());
+}
+
+static bool validDiagrams()
+{
+    for (DDBase<AAF>* d = DDBase<AAF>::registry; d != nullptr; d = d->reg_next)
+        if (d->root != nullptr and !validIndexes(d->root)) return false;
+    for (DDBase<bool>* d = DDBase<bool>::registry; d != nullptr; d = d->reg_next)
+        if (d->root != nullptr and !validIndexes(d->root)) return false;
+    return true;
+}
+
+static void step()
+{
+    ifS(level > 8)
+        rate = -1;
+    elseS
+        ifS(level < 2)
+            rate = 1;
+        endS;
+    endS;
+    level = level + rate;
+}
+
+int main()
+{
+    level = doubleS(4, 6);
+    rate  = doubleS(0.5, 1.5);
+    BDD high = false;
+
+    DDCheckpoint cp;
+    cp.add("level", level);
+    cp.add("rate", rate);
+    cp.add("high", high);
+
+    for (unsigned t=0; t < 4; t++) step();
+    high = (level > 7);
+
+    std::ostringstream os;
+    cp.save(os);
+    string buf = os.str();
+    unsigned long nconds = condMgr().size();
+    unsigned last = AAF::getDefault();
+
+    for (unsigned t=0; t < 4; t++) step();
+    unsigned leaves = level.numLeaves();
+
+    // diagrams that are not registered must not be used after a restore; hence the values
+    // of the first run are kept instead of the diagram.
+    double eps[2];
+    vector<double> first;
+    for (double e1=-1; e1 <= 1; e1 += 0.5)
+        for (double e2=-1; e2 <= 1; e2 += 0.5)
+        {
+            eps[0] = e1; eps[1] = e2;
+            first.push_back(level.Evaluate(eps, 2));
+        }
+
+    // the ids of the conditions are restored, even if they were reordered in the meantime.
+    condMgr().swapLevels(nconds-1);
+
+    // fork from the checkpoint and run the same steps again.
+    assert( cp.restore((const unsigned char*) buf.data(), buf.size()) );
+    assert( condMgr().size() == nconds );
+    for (unsigned long i=0; i < nconds; i++)
+        assert( condMgr().getId(i) < nconds and condMgr().getIndex(condMgr().getId(i)) == i );
+    assert( AAF::getDefault() == last );
+    assert( high.numLeaves() > 1 );
+
+    for (unsigned t=0; t < 4; t++) step();
+    assert( level.numLeaves() == leaves );
+
+    unsigned s = 0;
+    for (double e1=-1; e1 <= 1; e1 += 0.5)
+        for (double e2=-1; e2 <= 1; e2 += 0.5)
+        {
+            eps[0] = e1; eps[1] = e2;
+            assert( level.Evaluate(eps, 2) == first[s++] );
+        }
+
+    // reordering works on the restored ids.
+    condMgr().reorder();
+    s = 0;
+    for (double e1=-1; e1 <= 1; e1 += 0.5)
+        for (double e2=-1; e2 <= 1; e2 += 0.5)
+        {
+            eps[0] = e1; eps[1] = e2;
+            assert( level.Evaluate(eps, 2) == first[s++] );
+        }
+
+    // the stack of block conditions is restored as well.
+    ifS(rate > 0)
+        assert( cp.save("checkpoint.ckpt") == 0 );
+        nconds = condMgr().size();
+        assert( cp.restore("checkpoint.ckpt") == 1 );  // not in a conditional statement.
+        assert( condMgr().size() == nconds );
+    endS;
+    assert( !bCond().inCond() );
+    assert( cp.restore("checkpoint.ckpt") == 0 );
+    assert( bCond().inCond() );
+    bCond().endBlock(__LINE__, __FILE__);
+    remove("checkpoint.ckpt");
+
+    // a missing variable or corrupted data does not change the state.
+    BDD other;
+    cp.add("other", other);
+    nconds = condMgr().size();
+    assert( !cp.restore((const unsigned char*) buf.data(), buf.size()) );
+    assert( !cp.restore((const unsigned char*) buf.data(), buf.size()/2) );
+    assert( condMgr().size() == nconds );
+    for (unsigned long i=0; i < condMgr().size(); i++)
+        assert( condMgr().getId(i) < condMgr().size() and condMgr().getIndex(condMgr().getId(i)) == i );
+    condMgr().reorder();
+
+    // temporaries of the run after the checkpoint refer to conditions that do not exist after
+    // the restore; reordering must not touch them.
+    aaddShutdown();
+    aaddInit();
+    doubleS a = doubleS(0, 1), r = 0.0;
+    DDCheckpoint empty;
+    empty.add("r", r);
+    std::ostringstream es;
+    empty.save(es);
+    string ebuf = es.str();
+
+    for (unsigned i=0; i < 5; i++)
+    {
+        ifS(a > 0.1*i)
+            r = r + 1.;
+        endS;
+    }
+    assert( condMgr().size() == 5 );
+    assert( empty.restore((const unsigned char*) ebuf.data(), ebuf.size()) );
+    assert( condMgr().size() == 0 and r.numLeaves() == 1 );
+
+    doubleS b = doubleS(0, 1);
+    BDD b1 = (b > 0.2), b2 = (b > 0.5);
+    r = r + b;
+    assert( condMgr().size() == 2 );
+    assert( validDiagrams() );
+    condMgr().reorder();
+    condMgr().swapLevels(0);
+    assert( validDiagrams() );
+
+    cout << "Restored checkpoint of " << buf.size() << " bytes." << endl;
+}
@@ -0,0 +1,68 @@
+#include "../src/aadd.h"
+#include "../src/aadd_frozen.h"
+#include <assert.h>
+#include <math.h>
+
+//
+// Checks concrete evaluation of AADD and BDD at given values of the noise symbols.
+//
+int main()
+{
+    doubleS a = doubleS(0,2);    // 1+e1
+    ifS(a > 1)
+        a = a + 2;               // 3+e1
+    elseS
+        a = a - 2;               // -1+e1
+    endS;
+
+    double e1 = 0.5;
+    assert( fabs(a.Evaluate(&e1, 1) - 3.5) < 1e-12 );
+    e1 = -0.5;
+    assert( fabs(a.Evaluate(&e1, 1) + 1.5) < 1e-12 );
+
+    // batch of samples, one noise symbol per sample.
+    const unsigned M = 1000;
+    vector<double> samples(M);
+    for (unsigned s=0; s < M; s++) samples[s] = -1.0 + 2.0*s/(M-1);
+
+    vector<double> values = a.Evaluate(samples.data(), M, 1);
+    BDD b = (a > 0);
+    vector<bool> truth = b.Evaluate(samples.data(), M, 1);
+
+    for (unsigned s=0; s < M; s++)
+    {
+        assert( fabs(values[s] - a.Evaluate(&samples[s], 1)) < 1e-12 );
+        assert( truth[s] == b.Evaluate(&samples[s], 1) );
+        assert( truth[s] == (values[s] > 0) );
+    }
+
+    // the frozen diagram must give the same results.
+    FrozenDD fa(a);
+    assert( fa.numLeaves() == a.numLeaves() );
+    vector<double> fvalues = fa.Evaluate(samples.data(), M, 1);
+    for (unsigned s=0; s < M; s++)
+        assert( fvalues[s] == values[s] );
+
+    opt_sol bounds  = a.GetBothBounds();
+    opt_sol fbounds = fa.GetBothBounds();
+    assert( bounds.min == fbounds.min && bounds.max == fbounds.max );
+
+    AADD thawed;
+    thawed.setRoot(fa.thawAADD());
+    assert( thawed.numLeaves() == a.numLeaves() );
+    assert( thawed.Evaluate(&e1, 1) == a.Evaluate(&e1, 1) );
+
+    // the same for the BDD.
+    FrozenDD fb(b);
+    assert( fb.isBDD() and fb.numLeaves() == b.numLeaves() );
+    for (unsigned s=0; s < M; s++)
+        assert( fb.EvaluateBDD(&samples[s], 1) == truth[s] );
+
+    BDD bthawed;
+    bthawed.setRoot(fb.thawBDD());
+    assert( bthawed.numLeaves() == b.numLeaves() && bthawed.numNodes() == b.numNodes() );
+    for (unsigned s=0; s < M; s++)
+        assert( bthawed.Evaluate(&samples[s], 1) == truth[s] );
+
+    cout << "Evaluated " << M << " samples." << endl;
+}
@@ -0,0 +1,55 @@
+#include "../src/aadd.h"
+#include <assert.h>
+
+//
+// Checks that errors in a model throw exceptions and the library can be used afterwards.
+//
+int main()
+{
+    doubleS a = doubleS(0,2);
+    int errors = 0;
+
+    try {
+        bCond().endBlock(__LINE__, __FILE__);     // endS without ifS
+    } catch (AADD_Exception& e) {
+        assert( e.errorCode == AADD_SYNTAX_EXCEPTION );
+        errors++;
+    }
+
+    try {
+        ifS(a > 1)
+            a = floor(a);
+        endS;
+    } catch (AADD_Exception& e) {
+        assert( e.errorCode == AADD_RANGE_EXCEPTION );
+        errors++;
+    }
+    assert( bCond().inCond() );     // the block has not been ended.
+    aaddInit();
+    assert( !bCond().inCond() );
+
+    try {
+        a = a % 0;
+    } catch (AAF_Exception& e) {
+        assert( e.errorCode == AAF_DIVZERO_EXCEPTION );
+        errors++;
+    }
+
+    try {
+        AAF b(1, 2);
+        b /= 0.0;
+    } catch (AAF_Exception& e) {
+        assert( e.errorCode == AAF_DIVZERO_EXCEPTION );
+        errors++;
+    }
+    assert( errors == 4 );
+
+    // the next model runs as usual.
+    doubleS c = doubleS(0,2);
+    ifS(c > 1)
+        c = c + 2;
+    elseS
+        c = c - 2;
+    endS;
+    assert( c.numLeaves() == 2 );
+}
@@ -0,0 +1,85 @@
+#include "../src/aadd.h"
+#include "../src/aadd_expr.h"
+#include <assert.h>
+#include <math.h>
+
+//
+// Checks that expressions with lazy() give the same diagrams as the AADD operators.
+//
+void check_same(const AADD& a, const AADD& b)
+{
+    assert( a.numLeaves() == b.numLeaves() );
+    for (double e1=-1.0; e1 <= 1.0; e1 += 0.25)
+        for (double e2=-1.0; e2 <= 1.0; e2 += 0.25)
+        {
+            double eps[2] = {e1, e2};
+            assert( fabs(a.Evaluate(eps, 2) - b.Evaluate(eps, 2)) < 1e-12 );
+        }
+}
+
+int main()
+{
+    doubleS wlevel = doubleS(4,6);       // 5+e1
+    doubleS uncertainty = doubleS(-0.1,0.1);  // e2
+    double  T = 0.5;
+
+    ifS(wlevel > 5)
+        wlevel = wlevel - 1;
+    endS;
+    ifS(uncertainty > 0)
+        uncertainty = uncertainty * 2;
+    endS;
+
+    // operands with different conditions.
+    doubleS eager = wlevel+(1.+uncertainty)*T;
+    doubleS fused = lazy(wlevel)+(1.+lazy(uncertainty))*T;
+    check_same(eager, fused);
+    assert( fused.numLeaves() == 4 );
+
+    // all operators, constants and the same operand twice.
+    eager = -wlevel*wlevel/(uncertainty+3.) - AAF(2.);
+    fused = -lazy(wlevel)*wlevel/(uncertainty+3.) - AAF(2.);
+    check_same(eager, fused);
+
+    // the target as operand.
+    doubleS x = wlevel;
+    x = lazy(x)*2. + x;
+    check_same(x, wlevel*3.);
+
+    // assignment within a conditional statement.
+    doubleS y = 0.;
+    doubleS z = 0.;
+    ifS(uncertainty > 0)
+        y = uncertainty + wlevel;
+        z = lazy(uncertainty) + wlevel;
+    elseS
+        y = wlevel - 1.;
+        z = lazy(wlevel) - 1.;
+    endS;
+    check_same(y, z);
+
+    doubleS w(lazy(wlevel) + uncertainty);
+    check_same(w, wlevel + uncertainty);
+
+    // temporaries are held by the expression beyond their statement.
+    auto held = lazy(wlevel) + wlevel*uncertainty - lazy(uncertainty*2.);
+    doubleS v = held;
+    check_same(v, wlevel + wlevel*uncertainty - uncertainty*2.);
+    auto twice = lazy(wlevel*3.);
+    v = twice - wlevel;
+    check_same(v, wlevel*2.);
+
+    // a sum of scaled operands is computed with one affine form per leaf.
+    aaddStats().reset();
+    eager = wlevel*2. - uncertainty*0.5 + wlevel + 1.;
+    unsigned long eager_allocs = aaddStats().aaf_allocs;
+    aaddStats().reset();
+    fused = lazy(wlevel)*2. - lazy(uncertainty)*0.5 + wlevel + 1.;
+    check_same(eager, fused);
+#ifdef AADD_STATISTICS
+    assert( aaddStats().aaf_allocs < eager_allocs );
+#endif
+    (void) eager_allocs;
+
+    cout << "Expressions passed." << endl;
+}
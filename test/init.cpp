@@ -0,0 +1,29 @@
+#include "../src/aadd.h"
+#include <assert.h>
+
+//
+// Checks explicit initialization and shutdown; the library must not print anything.
+//
+int main()
+{
+    aaddInit();
+
+    doubleS a = doubleS(0,2);
+    ifS(a > 1)
+        a = a + 2;
+    endS;
+    assert( condMgr().size() == 1 );
+
+    aaddShutdown();
+    assert( condMgr().size() == 0 );
+    assert( !bCond().inCond() );
+
+    // the library can be started again.
+    aaddInit();
+    doubleS b = doubleS(0,2);
+    ifS(b > 1)
+        b = b + 2;
+    endS;
+    assert( condMgr().size() == 1 && b.numLeaves() == 2 );
+    aaddShutdown();
+}
@@ -0,0 +1,88 @@
+#include "../src/aadd.h"
+#include <assert.h>
+#include <math.h>
+
+//
+// Checks the analysis of whileS loops: unchanged states, widening, and the iteration limit.
+//
+int main()
+{
+    // without analysis, the loop runs until the condition is false.
+    doubleS a = doubleS(0, 2);
+    whileStateS(a < 10, a)
+    {
+        a = a + 1;
+    } endS;
+    opt_sol bounds = a.GetBothBounds();
+    assert( bounds.min >= 10-1e-9 and bounds.max <= 11+1e-9 );
+
+    loopOptions().analysis = true;
+    loopOptions().widen_after = 3;
+    loopOptions().max_iterations = 50;
+
+    // the same loop, widened; the result encloses the exact one.
+    loopCounters() = loop_counters();
+    doubleS b = doubleS(0, 2);
+    whileStateS(b < 10, b)
+    {
+        b = b + 1;
+    } endS;
+    opt_sol widened = b.GetBothBounds();
+    assert( widened.min <= bounds.min+1e-9 and widened.max >= bounds.max-1e-9 );
+    assert( loopCounters().loops == 1 and loopCounters().widenings > 0 );
+    assert( loopCounters().iterations < 10 );
+
+    // the widenings of a variable keep its noise symbol.
+    loopCounters() = loop_counters();
+    doubleS c = doubleS(0, 2);
+    unsigned last = AAF::getDefault();
+    whileStateS(c < 20, c)
+    {
+        c = c + 1;
+    } endS;
+    assert( loopCounters().widenings > 1 );
+    assert( AAF::getDefault() == last+1 );
+
+    // x never gets 0; the loop ends when its range is enclosed.
+    loopCounters() = loop_counters();
+    doubleS x = doubleS(0.5, 1);
+    doubleS n = 0.0;
+    whileStateS(x > 0, x, n)
+    {
+        x = x * 0.5;
+        ifS (n < 5)
+            n = n + 1;
+        endS;
+    } endS;
+    assert( loopCounters().fixed_points == 1 );
+    opt_sol xb = x.GetBothBounds();
+    assert( xb.min <= 1e-9 and xb.max > 0 and xb.max <= 0.125 );
+    assert( n.GetBothBounds().max >= 5-1e-9 );
+
+    // a state that does not change ends the loop.
+    loopCounters() = loop_counters();
+    doubleS y = doubleS(1, 2);
+    doubleS z = 3.0;
+    whileStateS(y > 0, z)
+    {
+        z = 3.0;
+    } endS;
+    assert( loopCounters().fixed_points == 1 and loopCounters().widenings == 0 );
+    assert( loopCounters().iterations == 1 );
+
+    // whileS without state is limited by max_iterations.
+    int errors = 0;
+    try {
+        doubleS w = doubleS(1, 2);
+        whileS(w > 0)
+        {
+            w = w * 0.5;
+        } endS;
+    } catch (AADD_Exception& e) {
+        assert( e.errorCode == AADD_LOOP_EXCEPTION );
+        errors++;
+    }
+    assert( errors == 1 );
+    aaddInit();
+    return 0;
+}
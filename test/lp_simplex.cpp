@@ -0,0 +1,267 @@
+#include "../src/aadd.h"
+#include "../src/aadd_lp_simplex.h"
+#include <assert.h>
+#include <math.h>
+#include <stdlib.h>
+
+//
+// Checks the in-library LP solver and the backends against GLPK.
+//
+static double rnd()
+{
+    return 2.0*rand()/RAND_MAX-1.0;
+}
+
+int main()
+{
+    // max e1+e2 s.t. e1+e2 <= 0.5, e1-e2 <= 0
+    BoxSimplex lp;
+    double a1[2] = { 1.0, 1.0 }, a2[2] = { 1.0, -1.0 }, c[2] = { 1.0, 1.0 };
+    lp.reset(2);
+    lp.addRow(a1, 0.5);
+    lp.addRow(a2, 0.0);
+    lp.setObjective(c);
+    double v;
+    assert( lp.maximize(v) == LP_OPTIMAL );
+    assert( fabs(v-0.5) < 1e-12 );
+    assert( lp.minimize(v) == LP_OPTIMAL );
+    assert( fabs(v+2.0) < 1e-12 );
+
+    // duals certify the maximum: c'e <= y'r + sum |c-A'y|
+    c[1] = 0.0;
+    lp.setObjective(c);
+    assert( lp.maximize(v) == LP_OPTIMAL );
+    double bound = lp.duals()[0]*0.5;
+    for (unsigned j=0; j < 2; j++)
+        bound += fabs(c[j]-lp.duals()[0]*a1[j]-lp.duals()[1]*a2[j]);
+    assert( fabs(v-0.25) < 1e-12 and fabs(bound-v) < 1e-12 );
+
+    // e1 <= -0.5 and -e1 <= -0.5 cannot hold
+    double b1[2] = { 1.0, 0.0 }, b2[2] = { -1.0, 0.0 };
+    lp.reset(2);
+    lp.addRow(b1, -0.5);
+    lp.addRow(b2, -0.5);
+    lp.setObjective(c);
+    assert( lp.maximize(v) == LP_INFEASIBLE );
+
+    // bounds of random affine forms under random constraints, as in FindBounds
+    srand(42);
+    const unsigned N = 12;
+    for (unsigned t=0; t < 200; t++)
+    {
+        AAF f(rnd());
+        for (unsigned i=1; i <= N; i++)
+            if (rand()%3) f = f + AAF(AAInterval(-fabs(rnd()), fabs(rnd())));
+        vector<constraint<AAF> > cons;
+        for (unsigned k=0; k < 1+t%4; k++)
+        {
+            constraint<AAF> con;
+            con.con = f*rnd() + AAF(0.3*rnd());
+            con.sign = rand()%2 ? '+' : '-';
+            cons.push_back(con);
+        }
+
+        lpOptions().solver = LP_SOLVER_GLPK;
+        opt_sol glpk = solve_lp(f, cons);
+        lpOptions().solver = LP_SOLVER_BUILTIN;
+        opt_sol own = solve_lp(f, cons);
+        assert( fabs(own.max-glpk.max) < 1e-6 );
+        assert( fabs(own.min-glpk.min) < 1e-6 );
+    }
+
+    // both backends through the interface, rows added and removed with warm start
+    BoxSimplex builtin;
+    GLPKBackend glpk;
+    LPBackend* backends[2] = { &builtin, &glpk };
+    const unsigned n = 6;
+    double rows[4][n], rhs[4], obj[n];
+    for (unsigned i=0; i < 4; i++)
+    {
+        for (unsigned j=0; j < n; j++) rows[i][j] = rnd();
+        rhs[i] = 0.5*rnd();
+    }
+    for (unsigned j=0; j < n; j++) obj[j] = rnd();
+
+    double values[2][8];
+    for (unsigned b=0; b < 2; b++)
+    {
+        LPBackend& lp = *backends[b];
+        unsigned k = 0;
+        lp.reset(n);
+        lp.setObjective(obj, 1.0);
+        for (unsigned i=0; i < 4; i++)
+        {
+            lp.addRow(rows[i], rhs[i]);
+            assert( lp.maximize(values[b][k++]) == LP_OPTIMAL );
+        }
+        lp.removeRow();
+        lp.removeRow();
+        assert( lp.numRows() == 2 );
+        assert( lp.minimize(values[b][k++]) == LP_OPTIMAL );
+        obj[0] = -obj[0];
+        lp.setObjective(obj, 1.0);
+        assert( lp.maximize(values[b][k++]) == LP_OPTIMAL );
+        obj[0] = -obj[0];
+    }
+    for (unsigned k=0; k < 6; k++)
+        assert( fabs(values[0][k]-values[1][k]) < 1e-9 );
+
+    // closed form for up to two rows agrees with the simplex whenever it exists
+    unsigned closed[3] = { 0, 0, 0 };
+    for (unsigned t=0; t < 300; t++)
+    {
+        const unsigned m = t%3;
+        double A[2*n], r[2], e[n], cf, sx;
+        for (unsigned j=0; j < 2*n; j++) A[j] = rnd();
+        for (unsigned j=0; j < n; j++) obj[j] = t%5 ? rnd() : 0.0;
+        r[0] = rnd(); r[1] = rnd();
+        builtin.reset(n);
+        for (unsigned i=0; i < m; i++) builtin.addRow(&A[i*n], r[i]);
+        builtin.setObjective(obj);
+        lp_status status = builtin.maximize(sx);
+        if (closedFormMax(n, m, A, r, obj, e, cf))
+        {
+            closed[m]++;
+            assert( status == LP_OPTIMAL and fabs(cf-sx) < 1e-9 );
+            for (unsigned i=0; i < m; i++)
+            {
+                double s = 0.0;
+                for (unsigned j=0; j < n; j++) s += A[i*n+j]*e[j];
+                assert( s <= r[i]+1e-9 );
+            }
+        }
+    }
+    assert( closed[0] == 100 and closed[1] > 50 and closed[2] > 10 );
+
+    // presolve: free symbols and independent blocks give the same bounds
+    vector<AAF> sym;
+    for (unsigned i=0; i < 10; i++) sym.push_back(AAF(AAInterval(-1.0, 1.0)));
+    for (unsigned t=0; t < 100; t++)
+    {
+        AAF f(rnd());
+        for (unsigned i=0; i < 10; i++) f = f + sym[i]*rnd();
+        vector<constraint<AAF> > cons;
+        for (unsigned k=0; k < 1+t%3; k++)
+        {
+            // constraints on two of the first six symbols, last one on all of them
+            constraint<AAF> con;
+            con.con = AAF(0.3*rnd()) + sym[rand()%6]*rnd() + sym[rand()%6]*rnd();
+            if (k == t%3) for (unsigned i=0; i < 6; i++) con.con = con.con + sym[i]*(0.1*rnd());
+            con.sign = rand()%2 ? '+' : '-';
+            cons.push_back(con);
+        }
+        for (unsigned mode=0; mode < 2; mode++)
+        {
+            lpOptions().solver = mode ? LP_SOLVER_GLPK : LP_SOLVER_BUILTIN;
+            lpOptions().presolve = false;
+            opt_sol full = solve_lp(f, cons);
+            lpOptions().presolve = true;
+            opt_sol presolved = solve_lp(f, cons);
+            assert( fabs(full.max-presolved.max) < 1e-9 );
+            assert( fabs(full.min-presolved.min) < 1e-9 );
+        }
+    }
+
+    // presolve: several blocks, and rows without objective that must hold as well
+    for (unsigned t=0; t < 100; t++)
+    {
+        AAF f(rnd());
+        for (unsigned i=0; i < 4; i++) f = f + sym[i]*rnd();
+        f = f + sym[8]*rnd();
+        vector<constraint<AAF> > cons;
+        for (unsigned k=0; k < 2+t%3; k++)
+        {
+            // blocks on the symbols 0, 1 and 2, 3
+            constraint<AAF> con;
+            unsigned b = 2*(k%2);
+            con.con = AAF(0.3*rnd()) + sym[b]*rnd() + sym[b+1]*rnd();
+            con.sign = rand()%2 ? '+' : '-';
+            cons.push_back(con);
+        }
+        // last one on symbols of no objective; every 4th cannot hold in the box.
+        constraint<AAF> con;
+        con.con = (t%4 == 0) ? AAF(2.5) + sym[6] + sym[7] : AAF(0.2*rnd()) + sym[6]*rnd() + sym[7];
+        con.sign = '-';
+        cons.push_back(con);
+        for (unsigned mode=0; mode < 2; mode++)
+        {
+            lpOptions().solver = mode ? LP_SOLVER_GLPK : LP_SOLVER_BUILTIN;
+            lpOptions().presolve = false;
+            opt_sol full = solve_lp(f, cons);
+            lpOptions().presolve = true;
+            opt_sol presolved = solve_lp(f, cons);
+            assert( fabs(full.max-presolved.max) < 1e-9 );
+            assert( fabs(full.min-presolved.min) < 1e-9 );
+        }
+    }
+
+    // certificates: any y >= 0 bounds the maximum, the optimal duals tightly
+    double ca[4] = { 1.0, 1.0, 1.0, -1.0 }, cr[2] = { 0.5, 0.0 }, cc[2] = { 1.0, 0.0 }, cy[2];
+    for (unsigned t=0; t < 20; t++)
+    {
+        for (unsigned i=0; i < 2; i++) cy[i] = fabs(rnd());
+        assert( certifiedMax(2, 2, ca, cr, cc, 0.0, cy) >= 0.25 );
+    }
+    cy[0] = cy[1] = 0.5;
+    assert( fabs(certifiedMax(2, 2, ca, cr, cc, 0.0, cy)-0.25) < 1e-12 );
+
+    // verified bounds enclose the bounds of the LP
+    lpOptions().verified = true;
+    for (unsigned t=0; t < 100; t++)
+    {
+        AAF f(rnd());
+        for (unsigned i=0; i < 10; i++) f = f + sym[i]*rnd();
+        vector<constraint<AAF> > cons;
+        constraint<AAF> con;
+        con.con = AAF(0.5*rnd());
+        for (unsigned i=0; i < 10; i++) con.con = con.con + sym[i]*rnd();
+        con.sign = rand()%2 ? '+' : '-';
+        cons.push_back(con);
+
+        for (unsigned mode=0; mode < 2; mode++)
+        {
+            lpOptions().solver = mode ? LP_SOLVER_GLPK : LP_SOLVER_BUILTIN;
+            lpOptions().verified = false;
+            opt_sol plain = solve_lp(f, cons);
+            lpOptions().verified = true;
+            opt_sol verified = solve_lp(f, cons);
+            if (lpVerification().last_weak) continue;
+            // the optimum of the solvers may be off by rounding errors
+            assert( fabs(verified.max-plain.max) < 1e-6*(1+fabs(plain.max)) );
+            assert( fabs(verified.min-plain.min) < 1e-6*(1+fabs(plain.min)) );
+            assert( verified.max-plain.max > -1e-12*(1+fabs(plain.max)) );
+            assert( plain.min-verified.min > -1e-12*(1+fabs(plain.min)) );
+        }
+    }
+    assert( lpVerification().certified > 100 );
+
+    // verified bounds take the symbols of all constraints: a+b >= 1 gives a >= 0, not a >= 1.
+    {
+        vector<constraint<AAF> > cons(2);
+        cons[0].con = sym[0] + sym[1] - 1.0;
+        cons[0].sign = '+';
+        cons[1].con = sym[0]*0.5 + 0.9;
+        cons[1].sign = '+';
+        for (unsigned mode=0; mode < 2; mode++)
+        {
+            lpOptions().solver = mode ? LP_SOLVER_GLPK : LP_SOLVER_BUILTIN;
+            opt_sol verified = solve_lp(sym[0], cons);
+            assert( verified.min <= 1e-9 and verified.max >= 1.0 );
+            if (lpVerification().last_weak) continue;
+            assert( verified.min > -1e-6 and verified.max < 1.0+1e-6 );
+        }
+    }
+    lpOptions().verified = false;
+
+    // comparison mode counts the problems and uses the results of GLPK
+    lpOptions().solver = LP_SOLVER_COMPARE;
+    lpComparison() = lp_comparison();
+    AADD a = doubleS(-1.0, 1.0);
+    ifS (a > 0.5)
+        a = a*2.0;
+    endS;
+    opt_sol bounds = a.GetBothBounds();
+    assert( lpComparison().problems == 2 and lpComparison().disagreements == 0 );
+    assert( fabs(bounds.max-2.0) < 1e-9 and fabs(bounds.min+1.0) < 1e-9 );
+    return 0;
+}
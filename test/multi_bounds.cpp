@@ -0,0 +1,120 @@
+#include "../src/aadd.h"
+#include "../src/aadd_lp_simplex.h"
+#include <assert.h>
+#include <math.h>
+
+//
+// Checks the bounds of several AADD with one LP per path against GetBothBounds.
+//
+// fails on objectives with the center 7, so that they are bounded by solve_lp alone.
+class FailingBackend: public BoxSimplex
+{
+public:
+    const char* name() const                    { return "failing"; };
+    void setObjective(const double* c, double c0=0.0)
+    {
+        fail = (c0 == 7.0);
+        BoxSimplex::setObjective(c, c0);
+    }
+    lp_status maximize(double& value)           { return fail ? LP_FAILED : BoxSimplex::maximize(value); };
+    lp_status minimize(double& value)           { return fail ? LP_FAILED : BoxSimplex::minimize(value); };
+private:
+    bool fail;
+};
+
+static bool encloses(const opt_sol& outer, const opt_sol& inner)
+{
+    const double tol = 1e-9;
+    return outer.min <= inner.min+tol*(1+fabs(inner.min)) and outer.max >= inner.max-tol*(1+fabs(inner.max));
+}
+
+int main()
+{
+    // the water level monitor; level and rate share their conditions.
+    AADD rate(.8);
+    AADD level(5.0);
+    AAF  uncertainty(-0.2, 0.2);
+    rate = rate + uncertainty;
+
+    for (int i=1; i < 12; i++)
+    {
+        ifS ( level >= 10.0 )
+            rate = -.8+uncertainty;
+        endS;
+        ifS ( level < 2.0 )
+            rate = .8+uncertainty;
+        endS;
+        level = level + rate;
+    }
+    AADD offset = level*0.5 + 1.0;
+
+    for (unsigned mode=0; mode < 3; mode++)
+    {
+        lpOptions().solver = mode == 0 ? LP_SOLVER_AUTO : mode == 1 ? LP_SOLVER_BUILTIN : LP_SOLVER_GLPK;
+
+        lpCounters() = lp_counters();
+        opt_sol l = level.GetBothBounds();
+        opt_sol r = rate.GetBothBounds();
+        opt_sol o = offset.GetBothBounds();
+        unsigned long separate = lpCounters().calls;
+
+        lpCounters() = lp_counters();
+        vector<const AADD*> vars;
+        vars.push_back(&level);
+        vars.push_back(&rate);
+        vars.push_back(&offset);
+        vector<opt_sol> bounds = GetBothBounds(vars);
+        assert( bounds.size() == 3 );
+        assert( lpCounters().calls < separate );
+
+        // the LP on all symbols of a path may be slightly wider.
+        assert( encloses(bounds[0], l) and encloses(bounds[1], r) and encloses(bounds[2], o) );
+        assert( fabs(bounds[0].max-l.max) < 1e-6 and fabs(bounds[0].min-l.min) < 1e-6 );
+        assert( fabs(bounds[1].max-r.max) < 1e-6 and fabs(bounds[1].min-r.min) < 1e-6 );
+    }
+    lpOptions().solver = LP_SOLVER_AUTO;
+
+    // AADD with different conditions and a constant
+    vector<AADD> mixed;
+    mixed.push_back(doubleS(-1.0, 1.0));
+    AADD b = doubleS(0.0, 2.0);
+    ifS (b > 1.0)
+        b = b*3.0;
+    endS;
+    mixed.push_back(b);
+    mixed.push_back(AADD(4.0));
+    vector<opt_sol> bounds = GetBothBounds(mixed);
+    for (unsigned i=0; i < mixed.size(); i++)
+        assert( encloses(bounds[i], mixed[i].GetBothBounds()) );
+    assert( fabs(bounds[1].max-6.0) < 1e-9 and fabs(bounds[1].min) < 1e-9 );
+    assert( bounds[2].min == 4.0 and bounds[2].max == 4.0 );
+    assert( GetBothBounds(vector<AADD>()).empty() );
+
+    // an objective without optimum does not change the LP of the others.
+    vector<AAF> sym;
+    for (unsigned i=0; i < 5; i++) sym.push_back(AAF(AAInterval(-1.0, 1.0)));
+    vector<constraint<AAF> > cons(2);
+    cons[0].con = sym[0] + sym[1]*0.5 - 0.3;
+    cons[0].sign = '-';
+    cons[1].con = sym[0]*0.1 + sym[1] - sym[2] + sym[3]*0.2 + 0.1;   // on all symbols, as on a path
+    cons[1].sign = '+';
+    vector<AAF> objs;
+    objs.push_back(sym[0]*2.0 + sym[3] + 7.0);
+    objs.push_back(sym[0] - sym[1] + sym[4]*0.5 + 1.0);     // a symbol of no condition
+    objs.push_back(sym[2]*0.5 + sym[3]*3.0 + sym[1]);
+    objs.push_back(sym[1]*-1.0 + sym[2] + 7.0);
+    objs.push_back(sym[3] - sym[0]);
+    vector<const AAF*> ptrs;
+    for (unsigned i=0; i < objs.size(); i++) ptrs.push_back(&objs[i]);
+
+    FailingBackend failing;
+    lpOptions().backend = &failing;
+    vector<opt_sol> multi = solve_lp(ptrs, cons);
+    for (unsigned i=0; i < objs.size(); i++)
+    {
+        opt_sol single = solve_lp(objs[i], cons);
+        assert( fabs(multi[i].max-single.max) < 1e-9 and fabs(multi[i].min-single.min) < 1e-9 );
+    }
+    lpOptions().backend = nullptr;
+    return 0;
+}
@@ -0,0 +1,59 @@
+#include "../src/aadd.h"
+#include <assert.h>
+#include <math.h>
+
+//
+// Checks the n-ary apply against repeated binary operations.
+//
+AAF Max3(const vector<AAF>& v)
+{
+    assert( v.size() == 3 );
+    AAF res = v[0];
+    if (v[1].getcenter() > res.getcenter()) res = v[1];
+    if (v[2].getcenter() > res.getcenter()) res = v[2];
+    return res;
+}
+
+int main()
+{
+    const unsigned K = 4;
+    vector<AADD> signals;
+    for (unsigned i=0; i < K; i++)
+    {
+        doubleS s = doubleS(i, i+2.);     // i+1+e(i+1)
+        ifS(s > i+1.)
+            s = s * 2.;
+        endS;
+        signals.push_back(s);
+    }
+
+    AADD expected = signals[0];
+    for (unsigned i=1; i < K; i++)
+        expected = expected + signals[i];
+
+    AADD result = sum(signals);
+    assert( result.numLeaves() == expected.numLeaves() );
+    assert( result.numLeaves() == 16 );
+
+    double eps[K];
+    for (unsigned s=0; s < (1u << K); s++)
+    {
+        for (unsigned i=0; i < K; i++) eps[i] = -1.0 + 2.0*((s >> i) % 2) * 0.75;
+        assert( fabs(result.Evaluate(eps, K) - expected.Evaluate(eps, K)) < 1e-12 );
+    }
+
+    // a user defined operation with the same AADD twice.
+    vector<const AADD*> args;
+    args.push_back(&signals[1]);
+    args.push_back(&signals[2]);
+    args.push_back(&signals[1]);
+    AADD m = apply(Max3, args);
+    assert( m.numLeaves() == 4 );
+
+    // no operands.
+    AADD zero = sum(vector<AADD>());
+    assert( zero.numLeaves() == 1 );
+    assert( zero.getRoot()->getValue().getcenter() == 0.0 );
+
+    cout << "N-ary apply passed." << endl;
+}
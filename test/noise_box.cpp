@@ -0,0 +1,72 @@
+#include "../src/aadd.h"
+#include "../src/aadd_box.h"
+#include <assert.h>
+#include <math.h>
+
+//
+// Checks the contraction of the noise symbols by path conditions and the pruning of paths.
+//
+int main()
+{
+    // e1+e2-1.5 >= 0 gives e1, e2 >= 0.5
+    AAF e1(AAInterval(-1.0, 1.0)), e2(AAInterval(-1.0, 1.0));
+    unsigned i1 = e1.getIndexes()[0], i2 = e2.getIndexes()[0];
+    NoiseBox box;
+    box.reset();
+    assert( box.push(e1+e2-AAF(1.5), '+') );
+    assert( fabs(box.lower(i1)-0.5) < 1e-12 and fabs(box.lower(i2)-0.5) < 1e-12 );
+    assert( box.upper(i1) == 1.0 );
+
+    double min, max;
+    box.bounds(e1-e2, min, max);
+    assert( min <= -0.5 and min > -0.5-1e-12 and max >= 0.5 and max < 0.5+1e-12 );
+
+    // e1-0.2 <= 0 cannot hold then.
+    assert( !box.push(e1-AAF(0.2), '-') );
+    assert( box.isEmpty() );
+    box.pop();
+    assert( !box.isEmpty() and box.numConds() == 1 );
+    box.pop();
+    assert( box.lower(i1) == -1.0 and box.lower(i2) == -1.0 );
+
+    // w has a path with x > 0.5 and x < 0.2.
+    AADD x = doubleS(-1.0, 1.0);
+    AADD y = x, z = x;
+    ifS (x > 0.5)
+        y = 1.0;
+    endS;
+    ifS (x < 0.2)
+        z = 2.0;
+    endS;
+    AADD w = y+z;
+
+    lpOptions().cache_bounds = false;
+    opt_sol plain = w.GetBothBounds();
+    lpOptions().contract_boxes = true;
+    opt_sol pruned = w.GetBothBounds();
+    assert( plain.max == 3.0 );
+    assert( fabs(pruned.max-2.2) < 1e-9 and fabs(pruned.min-0.4) < 1e-9 );
+
+    vector<opt_sol> leaves = w.GetAllBounds();
+    assert( leaves.size() == w.numLeaves() );
+    unsigned empty = 0;
+    for (unsigned i=0; i < leaves.size(); i++)
+        if (leaves[i].min > leaves[i].max) empty++;
+    assert( empty == 1 );
+
+    // without the infeasible path, w > 2.5 is false.
+    BDD above = w > 2.5;
+    assert( above.getRoot()->isLeaf() and above.getRoot()->getValue() == false );
+    lpOptions().contract_boxes = false;
+    BDD above_lp = w > 2.5;
+    assert( !above_lp.getRoot()->isLeaf() );
+    unsigned K = x.getRoot()->getValue().getIndexes()[0];
+    vector<double> point(K, 0.0);
+    for (double v=-1.0; v <= 1.0; v += 0.125)
+    {
+        point[K-1] = v;
+        double value = w.Evaluate(&point[0], K);
+        assert( value >= pruned.min-1e-9 and value <= pruned.max+1e-9 );
+    }
+    return 0;
+}
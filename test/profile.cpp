@@ -0,0 +1,61 @@
+#include "../src/aadd.h"
+#include <assert.h>
+#include <sstream>
+
+//
+// Checks that the profiler attributes conditions, blocks and assignments to their statements.
+//
+int main()
+{
+    profiler().enable();
+
+    doubleS a = doubleS(0,2);
+    doubleS b = doubleS(10,12);
+
+    for (int i=0; i < 3; i++)
+    {
+        ifS(a > 1)                            // line 17
+            a = a + 2;
+            ifS(b > 11)                       // line 19
+                b = b - 1;
+            endS;
+        elseS
+            a = a - 2;
+        endS;
+    }
+
+    whileS(b < 12)                            // line 27
+    {
+        b = b + 1;
+    } endS
+
+    vector<profileSite> sites = profiler().sites();
+    assert( sites.size() == 3 );
+
+    for (auto s: sites)
+    {
+        if (s.line == 17)
+        {
+            assert( s.kind == 'i' && s.entries == 3 && s.blocks == 3 );
+            assert( s.assigns == 6 );         // then and else part
+            assert( s.leaf_growth > 0 );
+        }
+        else if (s.line == 19)
+        {
+            assert( s.kind == 'i' && s.entries == 3 && s.assigns == 3 );
+        }
+        else
+        {
+            assert( s.line == 27 && s.kind == 'w' );
+            assert( s.entries == s.blocks+1 );  // last condition ends the loop
+            assert( s.assigns == s.blocks );
+        }
+    }
+
+    std::ostringstream report;
+    profiler().report(report, 2);
+    assert( report.str().find("profile.cpp:") != string::npos );
+    cout << report.str();
+
+    profiler().enable(false);
+}
@@ -0,0 +1,65 @@
+#include "../src/aadd.h"
+#include <assert.h>
+
+//
+// Checks swapping of levels and reordering of conditions.
+//
+template<class DD>
+vector<double> samples(const DD& a)
+{
+    vector<double> res;
+    for (double e1=-0.75; e1 <= 0.75; e1 += 0.5)
+        for (double e2=-0.75; e2 <= 0.75; e2 += 0.5)
+        {
+            double eps[2] = {e1, e2};
+            res.push_back(a.Evaluate(eps, 2));
+        }
+    return res;
+}
+
+int main()
+{
+    doubleS a(-1,1);     // e1
+    doubleS b(-1,1);     // e2
+    doubleS r = 3.;
+
+    ifS(a > 0)           // condition 0
+        r = 2.;
+    endS;
+    ifS(b > 0)           // condition 1
+        r = 1.;
+    endS;
+    BDD c = (a > 0) and (b > 0);
+
+    // r = c0 ? (c1 ? 1 : 2) : (c1 ? 1 : 3)
+    assert( r.numLeaves() == 4 );
+    unsigned long id0 = condMgr().getId(0);
+    unsigned long id1 = condMgr().getId(1);
+    vector<double> r_values = samples(r);
+    vector<double> c_values = samples(c);
+
+    // r = c1 ? 1 : (c0 ? 2 : 3)
+    condMgr().swapLevels(0);
+    assert( r.numLeaves() == 3 );
+    assert( condMgr().getIndex(id0) == 1 and condMgr().getIndex(id1) == 0 );
+    assert( samples(r) == r_values );
+    assert( samples(c) == c_values );
+
+    condMgr().swapLevels(0);
+    assert( r.numLeaves() == 4 );
+    assert( samples(r) == r_values );
+
+    // sifting finds the smaller order.
+    unsigned long before = condMgrC::liveNodes();
+    condMgr().reorder();
+    assert( condMgrC::liveNodes() <= before );
+    assert( r.numLeaves() == 3 );
+    assert( samples(r) == r_values );
+    assert( samples(c) == c_values );
+
+    // operations after reordering use the new order.
+    AADD sum = r + r;
+    assert( sum.numLeaves() == 3 );
+
+    cout << "Reordering passed." << endl;
+}
@@ -0,0 +1,89 @@
+#include "../src/aadd.h"
+#include "../src/aadd_serialize.h"
+#include <assert.h>
+#include <math.h>
+#include <sstream>
+
+//
+// Checks saving and loading of AADD and BDD in the binary format.
+//
+int main()
+{
+    doubleS a = doubleS(0,2);    // 1+e1
+    doubleS b = doubleS(-1,1);   // e2
+    ifS(a > 1)
+        a = a + b;
+    elseS
+        a = a - 2*b;
+    endS;
+    BDD c = (a > b);
+
+    assert( a.save("serialize_a.aadd") == 0 );
+    assert( c.save("serialize_c.aadd") == 0 );
+
+    AADD la;
+    BDD  lc;
+    assert( la.load("serialize_a.aadd") == 0 );
+    assert( lc.load("serialize_c.aadd") == 0 );
+
+    // loaded diagrams refer to new, equal conditions.
+    assert( la.numLeaves() == a.numLeaves() );
+    assert( lc.numLeaves() == c.numLeaves() );
+
+    double eps[2];
+    for (double e1=-1; e1 <= 1; e1 += 0.25)
+        for (double e2=-1; e2 <= 1; e2 += 0.25)
+        {
+            eps[0] = e1; eps[1] = e2;
+            assert( la.Evaluate(eps, 2) == a.Evaluate(eps, 2) );
+            assert( lc.Evaluate(eps, 2) == c.Evaluate(eps, 2) );
+        }
+
+    opt_sol bounds  = a.GetBothBounds();
+    opt_sol lbounds = la.GetBothBounds();
+    assert( fabs(bounds.min - lbounds.min) < 1e-9 && fabs(bounds.max - lbounds.max) < 1e-9 );
+
+    // several records in one stream; wrong kind, truncated data and bad header are rejected.
+    std::ostringstream os;
+    DDWriter w(os);
+    w.write(a);
+    w.write(c);
+    string buf = os.str();
+    const unsigned char* data = (const unsigned char*) buf.data();
+
+    DDReader r(data, buf.size());
+    AADD ra;
+    BDD  rc;
+    assert( !r.failed() && r.read(ra) && r.read(rc) && r.atEnd() );
+    assert( ra.numLeaves() == a.numLeaves() );
+
+    DDReader wrong(data, buf.size());
+    assert( !wrong.read(rc) );
+
+    DDReader truncated(data, buf.size()/2);
+    assert( !truncated.read(ra) && truncated.failed() );
+    assert( !truncated.read(rc) );
+
+    // a path that tests the same condition twice is deeper than the conditions allow.
+    std::ostringstream deep;
+    DDWriter dw(deep);
+    string dbuf = deep.str();
+    dbuf += 'A';
+    dbuf += '\1'; dbuf += '\0'; dbuf += string(25, '\0');   // condition with index 0
+    dbuf += '\1'; dbuf += string(25, '\0');                 // one leaf
+    dbuf += '\5'; dbuf += "\1\1";  dbuf += string(3, '\0'); // node, node, 3 leaves
+    DDReader dr((const unsigned char*) dbuf.data(), dbuf.size());
+    assert( !dr.failed() && !dr.read(ra) && dr.failed() );
+    dbuf.replace(dbuf.size()-6, 6, string("\3\1\0\0", 4));   // node, 2 leaves
+    DDReader dok((const unsigned char*) dbuf.data(), dbuf.size());
+    assert( dok.read(ra) && dok.atEnd() );
+
+    DDReader bad((const unsigned char*) "ADDA", 4);
+    assert( bad.failed() );
+
+    assert( la.load("does_not_exist.aadd") == 1 );
+
+    remove("serialize_a.aadd");
+    remove("serialize_c.aadd");
+    cout << "Saved and loaded " << buf.size() << " bytes." << endl;
+}
@@ -0,0 +1,36 @@
+#include "../src/aadd.h"
+#include <assert.h>
+#include <sstream>
+
+//
+// Checks the counters of operations; they are zero if AADD_STATISTICS is not set.
+//
+int main()
+{
+    aaddStats().reset();
+
+    doubleS a = doubleS(0,2);
+    ifS(a > 1)
+        a = a + 2;
+    elseS
+        a = a - 2;
+    endS;
+    opt_sol bounds = a.GetBothBounds();
+
+#ifdef AADD_STATISTICS
+    assert( aaddStats().node_allocs > 0 );
+    assert( aaddStats().apply_calls > 0 );
+    assert( aaddStats().conds_added == 1 );
+    assert( aaddStats().aaf_allocs > 0 );
+    assert( aaddStats().max_aaf_length >= 1 );
+    assert( aaddStats().lp_calls > 0 );
+#else
+    assert( aaddStats().node_allocs == 0 );
+    assert( aaddStats().lp_calls == 0 );
+#endif
+
+    std::ostringstream json;
+    aaddStats().printJSON(json);
+    assert( json.str().find("\"lp_calls\"") != string::npos );
+    cout << json.str() << "bounds: " << bounds.min << " " << bounds.max << endl;
+}
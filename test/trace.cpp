@@ -0,0 +1,49 @@
+#include "../src/aadd.h"
+#include "../src/aadd_trace.h"
+#include <assert.h>
+#include <math.h>
+
+//
+// Checks that the trace writer writes the same bounds as GetBothBounds, in order.
+//
+int main()
+{
+    doubleS level = doubleS(4, 6);
+    doubleS rate  = doubleS(0.5, 1.5);
+    vector<opt_sol> expected;
+
+    {
+        DDTraceWriter trace("trace.bin", 16, 4);
+        assert( trace.isOpen() );
+
+        for (unsigned t=0; t < 40; t++)
+        {
+            ifS(level > 8)
+                rate = -1;
+            elseS
+                ifS(level < 2)
+                    rate = 1;
+                endS;
+            endS;
+            level = level + rate;
+
+            trace.record(t, level);
+            expected.push_back(level.GetBothBounds());
+            if (t == 20) trace.flush();
+        }
+    }
+
+    vector<traceRecord> records;
+    assert( DDTraceWriter::readTrace("trace.bin", records) == 0 );
+    assert( records.size() == expected.size() );
+    for (unsigned t=0; t < records.size(); t++)
+    {
+        assert( records[t].time == t );
+        assert( fabs(records[t].min - expected[t].min) < 1e-9 );
+        assert( fabs(records[t].max - expected[t].max) < 1e-9 );
+        assert( records[t].leaves >= 1 );
+    }
+    remove("trace.bin");
+
+    cout << "Traced " << records.size() << " time steps." << endl;
+}